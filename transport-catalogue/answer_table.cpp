@@ -0,0 +1,56 @@
+#include "answer_table.h"
+
+namespace domain {
+
+AnswerTable::AnswerTable(FlatArray<char> text, FlatArray<uint64_t> offsets,
+                         FlatArray<uint32_t> id_positions)
+    : text_(std::move(text)), offsets_(std::move(offsets)),
+      id_positions_(std::move(id_positions)) {}
+
+void AnswerTable::build(const std::vector<std::string> &answers,
+                        std::vector<uint32_t> id_positions) {
+  std::vector<char> text;
+  std::vector<uint64_t> offsets{0};
+
+  offsets.reserve(answers.size() + 1);
+  for (const std::string &answer : answers) {
+    text.insert(text.end(), answer.begin(), answer.end());
+    offsets.push_back(text.size());
+  }
+
+  text_ = std::move(text);
+  offsets_ = std::move(offsets);
+  id_positions_ = std::move(id_positions);
+}
+
+std::string AnswerTable::get(uint32_t id, int request_id) const {
+  const std::string_view answer = get_answer(id);
+  const size_t id_position = id_positions_[id];
+  std::string result;
+
+  result.reserve(answer.size() + 11);
+  result.append(answer.substr(0, id_position));
+  result.append(std::to_string(request_id));
+  result.append(answer.substr(id_position));
+
+  return result;
+}
+
+std::string_view AnswerTable::get_answer(uint32_t id) const {
+  return {text_.data() + offsets_[id],
+          static_cast<size_t>(offsets_[id + 1] - offsets_[id])};
+}
+
+bool AnswerTable::empty() const { return id_positions_.empty(); }
+
+const FlatArray<char> &AnswerTable::get_text() const { return text_; }
+
+const FlatArray<uint64_t> &AnswerTable::get_offsets() const {
+  return offsets_;
+}
+
+const FlatArray<uint32_t> &AnswerTable::get_id_positions() const {
+  return id_positions_;
+}
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flat_array.h"
+
+namespace domain {
+
+// Answers serialized ahead of time, one per stop or bus id. An answer is
+// kept without the value of its request_id; the value is spliced in at the
+// stored position when the answer is given.
+class AnswerTable {
+public:
+  AnswerTable() = default;
+  AnswerTable(FlatArray<char> text, FlatArray<uint64_t> offsets,
+              FlatArray<uint32_t> id_positions);
+
+  void build(const std::vector<std::string> &answers,
+             std::vector<uint32_t> id_positions);
+
+  std::string get(uint32_t id, int request_id) const;
+  std::string_view get_answer(uint32_t id) const;
+  bool empty() const;
+
+  const FlatArray<char> &get_text() const;
+  const FlatArray<uint64_t> &get_offsets() const;
+  const FlatArray<uint32_t> &get_id_positions() const;
+
+private:
+  FlatArray<char> text_;
+  FlatArray<uint64_t> offsets_;
+  FlatArray<uint32_t> id_positions_;
+};
+
+} // end namespace domain
\ No newline at end of file
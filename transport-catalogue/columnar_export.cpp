@@ -0,0 +1,174 @@
+#include "columnar_export.h"
+#include "json_builder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace columnar_export {
+
+using namespace transport_catalogue;
+using namespace transport_catalogue::detail::json;
+using namespace transport_catalogue::detail::json::builder;
+
+namespace {
+
+template <typename T> struct ColumnType;
+template <> struct ColumnType<uint8_t> {
+  static constexpr const char *name = "u8";
+};
+template <> struct ColumnType<uint32_t> {
+  static constexpr const char *name = "u32";
+};
+template <> struct ColumnType<uint64_t> {
+  static constexpr const char *name = "u64";
+};
+template <> struct ColumnType<double> {
+  static constexpr const char *name = "f64";
+};
+template <> struct ColumnType<char> {
+  static constexpr const char *name = "bytes";
+};
+
+class ColumnWriter {
+public:
+  ColumnWriter(std::filesystem::path directory, Array &schema)
+      : directory_(std::move(directory)), schema_(schema) {}
+
+  template <typename T, typename Generator>
+  void write(const std::string &name, size_t size, Generator generator) {
+    std::ofstream out(directory_ / name, std::ios::binary);
+
+    for (size_t i = 0; i < size; ++i) {
+      const T value = generator(i);
+      out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    good_ = good_ && out.good();
+    schema_.emplace_back(Builder{}
+                             .start_dict()
+                             .key("file")
+                             .value(name)
+                             .key("type")
+                             .value(std::string(ColumnType<T>::name))
+                             .key("length")
+                             .value(static_cast<int>(size))
+                             .end_dict()
+                             .build());
+  }
+
+  bool good() const { return good_; }
+
+private:
+  std::filesystem::path directory_;
+  Array &schema_;
+  bool good_ = true;
+};
+
+template <typename Entity>
+void write_names(ColumnWriter &writer, const std::string &prefix,
+                 const FrozenCatalogue &catalogue,
+                 const domain::FlatArray<Entity> &entities) {
+  std::vector<char> names;
+  std::vector<uint64_t> offsets{0};
+
+  for (const Entity &entity : entities) {
+    const std::string_view name = catalogue.get_name(entity.name);
+    names.insert(names.end(), name.begin(), name.end());
+    offsets.push_back(names.size());
+  }
+
+  writer.write<uint64_t>(prefix + "_name_offsets.u64", offsets.size(),
+                         [&offsets](size_t i) { return offsets[i]; });
+  writer.write<char>(prefix + "_names.bytes", names.size(),
+                     [&names](size_t i) { return names[i]; });
+}
+
+} // end namespace
+
+bool export_catalogue(const FrozenCatalogue &catalogue,
+                      const ExportSettings &export_settings) {
+  const std::filesystem::path directory(export_settings.directory);
+  std::error_code error;
+
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    std::cout << "export: cannot create " << directory.string() << std::endl;
+    return false;
+  }
+
+  Array schema;
+  ColumnWriter writer(directory, schema);
+
+  const auto &stops = catalogue.get_stops();
+  const auto &buses = catalogue.get_buses();
+
+  writer.write<uint32_t>("stop_id.u32", stops.size(), [](size_t i) {
+    return static_cast<uint32_t>(i);
+  });
+  write_names(writer, "stop", catalogue, stops);
+  writer.write<double>("stop_latitude.f64", stops.size(), [&stops](size_t i) {
+    return stops[i].coordinates.latitude;
+  });
+  writer.write<double>("stop_longitude.f64", stops.size(), [&stops](size_t i) {
+    return stops[i].coordinates.longitude;
+  });
+
+  // Bus stops are written as stored: a non-roundtrip bus lists its way out
+  // only and returns along the same stops.
+  std::vector<uint32_t> bus_stop_offsets{0};
+  std::vector<uint32_t> bus_stops;
+
+  for (const FrozenBus &bus : buses) {
+    const RouteView route = catalogue.get_bus_stops(bus);
+
+    for (size_t i = 0; i < bus.stops_end - bus.stops_begin; ++i) {
+      bus_stops.push_back(route[i]);
+    }
+    bus_stop_offsets.push_back(static_cast<uint32_t>(bus_stops.size()));
+  }
+
+  writer.write<uint32_t>("bus_id.u32", buses.size(), [](size_t i) {
+    return static_cast<uint32_t>(i);
+  });
+  write_names(writer, "bus", catalogue, buses);
+  writer.write<uint8_t>("bus_is_roundtrip.u8", buses.size(),
+                        [&buses](size_t i) {
+                          return static_cast<uint8_t>(buses[i].is_roundtrip);
+                        });
+  writer.write<uint64_t>("bus_route_length.u64", buses.size(),
+                         [&buses](size_t i) {
+                           return static_cast<uint64_t>(buses[i].route_length);
+                         });
+  writer.write<uint32_t>(
+      "bus_stop_offsets.u32", bus_stop_offsets.size(),
+      [&bus_stop_offsets](size_t i) { return bus_stop_offsets[i]; });
+  writer.write<uint32_t>("bus_stops.u32", bus_stops.size(),
+                         [&bus_stops](size_t i) { return bus_stops[i]; });
+
+  // Road distances with the reverse direction already filled in, so the row
+  // of a stop holds every distance measured from it.
+  const auto &distances = catalogue.get_distance_table();
+
+  writer.write<uint32_t>(
+      "distance_offsets.u32", distances.get_offsets().size(),
+      [&distances](size_t i) { return distances.get_offsets()[i]; });
+  writer.write<uint32_t>(
+      "distance_stops.u32", distances.get_neighbours().size(),
+      [&distances](size_t i) { return distances.get_neighbours()[i]; });
+  writer.write<uint32_t>(
+      "distances.u32", distances.get_distances().size(),
+      [&distances](size_t i) { return distances.get_distances()[i]; });
+
+  std::ofstream schema_file(directory / "schema.json");
+  print(Document{Node(schema)}, schema_file);
+
+  if (!writer.good() || !schema_file.good()) {
+    std::cout << "export: cannot write " << directory.string() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+} // end namespace columnar_export
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "frozen_catalogue.h"
+
+#include <string>
+
+namespace columnar_export {
+
+struct ExportSettings {
+  std::string directory;
+};
+
+// Writes the catalogue as one file per column for tools that mmap them. Every
+// column is a flat array of fixed-width native-endian values written in one
+// sequential pass; variable-length data (names, bus stops, road distances)
+// is a values column plus an offsets column with one extra trailing entry.
+// schema.json in the same directory lists the files with their element type
+// and length.
+bool export_catalogue(const transport_catalogue::FrozenCatalogue &catalogue,
+                      const ExportSettings &export_settings);
+
+} // end namespace columnar_export
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "csv_reader.h"
+
+#include <algorithm>
+
+namespace csv {
+
+bool CsvReader::open(const std::string &path) {
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  file_.advise_sequential();
+
+  data_ = file_.get_data();
+  pos_ = 0;
+  released_ = 0;
+
+  if (data_.substr(0, 3) == "\xEF\xBB\xBF") {
+    pos_ = 3;
+  }
+
+  header_.clear();
+
+  if (read_row()) {
+    header_.assign(fields_.begin(), fields_.end());
+  }
+
+  return true;
+}
+
+int CsvReader::get_column(std::string_view name) const {
+  auto it = std::find(header_.begin(), header_.end(), name);
+  return it != header_.end() ? static_cast<int>(it - header_.begin()) : -1;
+}
+
+bool CsvReader::read_row() {
+  if (pos_ - released_ >= RELEASE_STEP) {
+    file_.release(pos_);
+    released_ = pos_;
+  }
+
+  while (parse_row()) {
+    if (fields_.size() > 1 || !fields_[0].empty()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::string_view CsvReader::get_field(int column) const {
+  if (column < 0 || static_cast<size_t>(column) >= fields_.size()) {
+    return {};
+  }
+
+  return fields_[column];
+}
+
+std::string_view CsvReader::parse_quoted_field(size_t index) {
+  const size_t begin = ++pos_;
+  bool escaped = false;
+
+  while (pos_ < data_.size()) {
+    if (data_[pos_] == '"') {
+      if (pos_ + 1 < data_.size() && data_[pos_ + 1] == '"') {
+        escaped = true;
+        pos_ += 2;
+        continue;
+      }
+      break;
+    }
+    ++pos_;
+  }
+
+  std::string_view field = data_.substr(begin, pos_ - begin);
+
+  // Anything between the closing quote and the delimiter is ignored.
+  while (pos_ < data_.size() && data_[pos_] != ',' && data_[pos_] != '\n' &&
+         data_[pos_] != '\r') {
+    ++pos_;
+  }
+
+  if (!escaped) {
+    return field;
+  }
+
+  while (unquoted_.size() <= index) {
+    unquoted_.emplace_back();
+  }
+
+  std::string &buffer = unquoted_[index];
+  buffer.clear();
+
+  for (size_t i = 0; i < field.size(); ++i) {
+    buffer.push_back(field[i]);
+
+    if (field[i] == '"') {
+      ++i;
+    }
+  }
+
+  return buffer;
+}
+
+bool CsvReader::parse_row() {
+  fields_.clear();
+
+  if (pos_ >= data_.size()) {
+    return false;
+  }
+
+  while (true) {
+    if (data_[pos_] == '"') {
+      fields_.push_back(parse_quoted_field(fields_.size()));
+
+    } else {
+      const size_t begin = pos_;
+
+      while (pos_ < data_.size() && data_[pos_] != ',' &&
+             data_[pos_] != '\n' && data_[pos_] != '\r') {
+        ++pos_;
+      }
+
+      fields_.push_back(data_.substr(begin, pos_ - begin));
+    }
+
+    if (pos_ < data_.size() && data_[pos_] == ',') {
+      ++pos_;
+
+      if (pos_ == data_.size()) {
+        fields_.emplace_back();
+        return true;
+      }
+      continue;
+    }
+
+    break;
+  }
+
+  if (pos_ < data_.size() && data_[pos_] == '\r') {
+    ++pos_;
+  }
+  if (pos_ < data_.size() && data_[pos_] == '\n') {
+    ++pos_;
+  }
+
+  return true;
+}
+
+} // end namespace csv
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace csv {
+
+// RFC 4180 reader over a mapped file. Fields are views into the mapping, only
+// quoted fields with escaped quotes are copied, into buffers that are reused
+// from row to row.
+class CsvReader {
+public:
+  bool open(const std::string &path);
+
+  // Index of the column with the given header name, or -1.
+  int get_column(std::string_view name) const;
+
+  bool read_row();
+  // Field of the current row, empty for a missing column.
+  std::string_view get_field(int column) const;
+
+private:
+  static const size_t RELEASE_STEP = size_t(64) << 20;
+
+  bool parse_row();
+  std::string_view parse_quoted_field(size_t index);
+
+  domain::MappedFile file_;
+  std::string_view data_;
+  size_t pos_ = 0;
+  size_t released_ = 0;
+
+  std::vector<std::string> header_;
+  std::vector<std::string_view> fields_;
+  std::deque<std::string> unquoted_;
+};
+
+} // end namespace csv
\ No newline at end of file
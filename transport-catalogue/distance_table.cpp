@@ -0,0 +1,85 @@
+#include "distance_table.h"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace domain {
+
+DistanceTable::DistanceTable(FlatArray<uint32_t> offsets,
+                             FlatArray<uint32_t> neighbours,
+                             FlatArray<uint32_t> distances)
+    : offsets_(std::move(offsets)), neighbours_(std::move(neighbours)),
+      distances_(std::move(distances)) {}
+
+void DistanceTable::build(size_t stops_count, std::vector<Entry> entries) {
+  const size_t explicit_count = entries.size();
+
+  for (size_t i = 0; i < explicit_count; ++i) {
+    entries.push_back({entries[i].to, entries[i].from, entries[i].distance});
+  }
+
+  // Explicit entries come first among equal pairs, so unique() keeps them
+  // and drops the reverse copies they shadow.
+  std::vector<size_t> order(entries.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&entries](size_t lhs, size_t rhs) {
+                     return std::tie(entries[lhs].from, entries[lhs].to) <
+                            std::tie(entries[rhs].from, entries[rhs].to);
+                   });
+
+  std::vector<uint32_t> offsets(stops_count + 1, 0);
+  std::vector<uint32_t> neighbours;
+  std::vector<uint32_t> distances;
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    const Entry &entry = entries[order[i]];
+
+    if (i > 0 && entry.from == entries[order[i - 1]].from &&
+        entry.to == entries[order[i - 1]].to) {
+      continue;
+    }
+
+    ++offsets[entry.from + 1];
+    neighbours.push_back(entry.to);
+    distances.push_back(entry.distance);
+  }
+
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+
+  offsets_ = std::move(offsets);
+  neighbours_ = std::move(neighbours);
+  distances_ = std::move(distances);
+}
+
+size_t DistanceTable::find(uint32_t from, uint32_t to) const {
+  if (from + 1 >= offsets_.size()) {
+    return 0;
+  }
+
+  const auto first = neighbours_.begin() + offsets_[from];
+  const auto last = neighbours_.begin() + offsets_[from + 1];
+  const auto it = std::lower_bound(first, last, to);
+
+  return it != last && *it == to ? distances_[it - neighbours_.begin()] : 0;
+}
+
+bool DistanceTable::empty() const { return neighbours_.empty(); }
+
+const FlatArray<uint32_t> &DistanceTable::get_offsets() const {
+  return offsets_;
+}
+
+const FlatArray<uint32_t> &DistanceTable::get_neighbours() const {
+  return neighbours_;
+}
+
+const FlatArray<uint32_t> &DistanceTable::get_distances() const {
+  return distances_;
+}
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flat_array.h"
+
+namespace domain {
+
+// Road distances in compressed sparse row form: the row of a stop lists
+// (neighbour id, distance) pairs sorted by neighbour. A pair given only in
+// one direction is copied to the opposite row on build, so a lookup is a
+// single binary search within one row.
+class DistanceTable {
+public:
+  struct Entry {
+    uint32_t from;
+    uint32_t to;
+    uint32_t distance;
+  };
+
+  DistanceTable() = default;
+  DistanceTable(FlatArray<uint32_t> offsets, FlatArray<uint32_t> neighbours,
+                FlatArray<uint32_t> distances);
+
+  void build(size_t stops_count, std::vector<Entry> entries);
+
+  size_t find(uint32_t from, uint32_t to) const;
+  bool empty() const;
+
+  const FlatArray<uint32_t> &get_offsets() const;
+  const FlatArray<uint32_t> &get_neighbours() const;
+  const FlatArray<uint32_t> &get_distances() const;
+
+private:
+  FlatArray<uint32_t> offsets_;
+  FlatArray<uint32_t> neighbours_;
+  FlatArray<uint32_t> distances_;
+};
+
+} // end namespace domain
\ No newline at end of file
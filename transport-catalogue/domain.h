@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -16,28 +19,93 @@ struct StatRequest {
   std::string name;
   std::string from;
   std::string to;
+
+  geo::Coordinates coordinates{};
+  int count = 0;
+  geo::BoundingBox area{};
+
+  int from_index = 0;
+  int to_index = 0;
+
+  int limit = 0;
+  int max_edits = 0;
 };
 
 struct Bus;
+struct Stop;
 
+// A road distance from a stop to a neighbour. A distance given only from
+// the neighbour is kept in this stop's row as well, with is_given false,
+// so a lookup in either direction reads a single row.
+struct RoadDistance {
+  const Stop *neighbour;
+  int distance;
+  bool is_given;
+};
+
+// Stop and Bus are allocator-aware, so the containers of a catalogue place
+// their nested vectors in the catalogue arena too.
 struct Stop {
-  std::string name;
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+  Stop() = default;
+  Stop(const Stop &other) = default;
+  Stop(Stop &&other) = default;
+  Stop &operator=(const Stop &other) = default;
+  Stop &operator=(Stop &&other) = default;
+
+  explicit Stop(const allocator_type &alloc)
+      : buses(alloc), distances(alloc) {}
+  Stop(const Stop &other, const allocator_type &alloc)
+      : name(other.name), latitude(other.latitude),
+        longitude(other.longitude), buses(other.buses, alloc),
+        distances(other.distances, alloc) {}
+  Stop(Stop &&other, const allocator_type &alloc)
+      : name(other.name), latitude(other.latitude),
+        longitude(other.longitude), buses(std::move(other.buses), alloc),
+        distances(std::move(other.distances), alloc) {}
+
+  std::string_view name;
   double latitude;
   double longitude;
 
-  std::vector<Bus *> buses;
+  std::pmr::vector<Bus *> buses;
+
+  // Road distances from this stop, sorted by the neighbour.
+  std::pmr::vector<RoadDistance> distances;
 };
 
 struct Bus {
-  std::string name;
-  std::vector<Stop *> stops;
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+  Bus() = default;
+  Bus(const Bus &other) = default;
+  Bus(Bus &&other) = default;
+  Bus &operator=(const Bus &other) = default;
+  Bus &operator=(Bus &&other) = default;
+
+  explicit Bus(const allocator_type &alloc) : stops(alloc) {}
+  Bus(const Bus &other, const allocator_type &alloc)
+      : name(other.name), stops(other.stops, alloc),
+        is_roundtrip(other.is_roundtrip), route_length(other.route_length),
+        geo_length(other.geo_length) {}
+  Bus(Bus &&other, const allocator_type &alloc)
+      : name(other.name), stops(std::move(other.stops), alloc),
+        is_roundtrip(other.is_roundtrip), route_length(other.route_length),
+        geo_length(other.geo_length) {}
+
+  std::string_view name;
+
+  // A non-roundtrip bus keeps only the way out, its way back is implied.
+  std::pmr::vector<Stop *> stops;
   bool is_roundtrip;
   size_t route_length;
+  double geo_length = 0.;
 };
 
 struct Distance {
-  const Stop *start;
-  const Stop *end;
+  Stop *start;
+  Stop *end;
   int distance;
 };
 
@@ -53,7 +121,7 @@ struct BusQueryResult {
 struct StopQueryResult {
   std::string_view name;
   bool not_found;
-  std::vector<std::string> buses_name;
+  std::vector<std::string_view> buses_name;
 };
 
 struct StopEdge {
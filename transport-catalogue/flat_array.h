@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace domain {
+
+// Read-only contiguous array that either owns its elements or refers to
+// memory owned by someone else, such as a section of a mapped base file.
+// Indexes keep their tables in FlatArrays, so the same code serves a freshly
+// built index and one used in place from the file.
+template <typename T> class FlatArray {
+public:
+  FlatArray() = default;
+  FlatArray(std::vector<T> values) : values_(std::move(values)) {}
+  template <typename It>
+  FlatArray(It first, It last) : values_(first, last) {}
+
+  // The memory must outlive the array and all of its copies.
+  static FlatArray view(const T *data, size_t size) {
+    FlatArray result;
+    result.view_ = data;
+    result.view_size_ = size;
+    return result;
+  }
+
+  const T *data() const { return view_ ? view_ : values_.data(); }
+  size_t size() const { return view_ ? view_size_ : values_.size(); }
+  bool empty() const { return size() == 0; }
+
+  const T *begin() const { return data(); }
+  const T *end() const { return data() + size(); }
+
+  const T &operator[](size_t pos) const { return data()[pos]; }
+  const T &back() const { return data()[size() - 1]; }
+
+private:
+  std::vector<T> values_;
+  const T *view_ = nullptr;
+  size_t view_size_ = 0;
+};
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "flat_base.h"
+
+namespace domain {
+
+static size_t align_up(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+void FlatWriter::write(std::ostream &out) const {
+  FlatHeader header;
+
+  std::memcpy(header.magic, FlatHeader::MAGIC, sizeof(header.magic));
+  header.version = FlatHeader::VERSION;
+  header.endianness = FlatHeader::ENDIANNESS;
+  header.sections_count = static_cast<uint32_t>(sections_.size());
+  header.reserved = 0;
+
+  std::vector<FlatSectionEntry> entries;
+  size_t offset =
+      sizeof(FlatHeader) + sections_.size() * sizeof(FlatSectionEntry);
+
+  for (const Section &section : sections_) {
+    offset = align_up(offset, SECTION_ALIGNMENT);
+
+    FlatSectionEntry entry = section.entry;
+    entry.offset = offset;
+    entries.push_back(entry);
+
+    offset += section.data.size();
+  }
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(entries.data()),
+            entries.size() * sizeof(FlatSectionEntry));
+
+  size_t written =
+      sizeof(FlatHeader) + entries.size() * sizeof(FlatSectionEntry);
+  const std::string padding(SECTION_ALIGNMENT, '\0');
+
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    out.write(padding.data(), entries[i].offset - written);
+    out.write(sections_[i].data.data(), sections_[i].data.size());
+
+    written = entries[i].offset + sections_[i].data.size();
+  }
+}
+
+bool FlatReader::open(const std::string &path) {
+  sections_.clear();
+
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  const std::string_view data = file_.get_data();
+  FlatHeader header;
+
+  if (data.size() < sizeof(header)) {
+    file_.close();
+    return false;
+  }
+
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  if (std::memcmp(header.magic, FlatHeader::MAGIC, sizeof(header.magic)) !=
+      0) {
+    file_.close();
+    return false;
+  }
+
+  if (header.version != FlatHeader::VERSION ||
+      header.endianness != FlatHeader::ENDIANNESS) {
+    throw std::runtime_error("unsupported flat base version or byte order");
+  }
+
+  const size_t table_end =
+      sizeof(header) + header.sections_count * sizeof(FlatSectionEntry);
+
+  if (data.size() < table_end) {
+    throw std::runtime_error("flat base is truncated");
+  }
+
+  sections_.resize(header.sections_count);
+  std::memcpy(sections_.data(), data.data() + sizeof(header),
+              sections_.size() * sizeof(FlatSectionEntry));
+
+  for (const FlatSectionEntry &section : sections_) {
+    if (section.offset > data.size() ||
+        section.size > data.size() - section.offset) {
+      throw std::runtime_error("flat base is truncated");
+    }
+  }
+
+  return true;
+}
+
+const FlatSectionEntry *FlatReader::find_section(FlatSection id) const {
+  for (const FlatSectionEntry &section : sections_) {
+    if (section.id == static_cast<uint32_t>(id)) {
+      return &section;
+    }
+  }
+
+  return nullptr;
+}
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "flat_array.h"
+#include "mapped_file.h"
+
+namespace domain {
+
+// Sections of a flat base. The values are stored in the file, so they must
+// never be reused; a new kind of data gets a new id. Id 1 belonged to a
+// section of a format version that no build reads any more.
+enum class FlatSection : uint32_t {
+  NAMES = 2,
+  STOPS = 3,
+  BUSES = 4,
+  BUS_STOP_IDS = 5,
+  BUS_RANKS = 6,
+  STOP_BUS_IDS = 7,
+  STOP_FIRST_POSITIONS = 8,
+  STOP_LAST_POSITIONS = 9,
+  ROAD_LENGTHS = 10,
+  ROAD_BACK_LENGTHS = 11,
+  GEO_LENGTHS = 12,
+  DISTANCE_OFFSETS = 13,
+  DISTANCE_NEIGHBOURS = 14,
+  DISTANCES = 15,
+  INDEX_SEEDS = 16,
+  STOP_INDEX_DISPLACEMENTS = 17,
+  STOP_INDEX_SLOTS = 18,
+  BUS_INDEX_DISPLACEMENTS = 19,
+  BUS_INDEX_SLOTS = 20,
+  STOP_TRIE_LABELS = 21,
+  STOP_TRIE_CHILDREN_BEGIN = 22,
+  STOP_TRIE_VALUES = 23,
+  SPATIAL_INDEX_IDS = 24,
+  SPATIAL_INDEX_BOXES = 25,
+  NETWORK_COUNTS = 26,
+  BUSIEST_STOPS = 27,
+  LONGEST_BUSES = 28,
+  STOP_BUS_COUNT_HISTOGRAM = 29,
+  ROUTE_LENGTH_HISTOGRAM = 30,
+  RENDER_SETTINGS = 31,
+  ROUTING_SETTINGS = 32,
+  MAP = 33,
+  STOP_ANSWERS = 34,
+  STOP_ANSWER_OFFSETS = 35,
+  STOP_ANSWER_ID_POSITIONS = 36,
+  BUS_ANSWERS = 37,
+  BUS_ANSWER_OFFSETS = 38,
+  BUS_ANSWER_ID_POSITIONS = 39,
+};
+
+// Layout of a flat base file: a header, a table of sections and the
+// sections themselves, each starting at a multiple of SECTION_ALIGNMENT. A
+// section is a plain array of trivially copyable records written as they are
+// in memory, so a reader maps the file and uses the arrays in place; opening
+// a base costs the same for any network size.
+struct FlatHeader {
+  static constexpr char MAGIC[8] = {'T', 'C', 'F', 'L', 'A', 'T', '\0', '\0'};
+  static const uint32_t VERSION = 2;
+  static const uint32_t ENDIANNESS = 0x01020304;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t endianness;
+  uint32_t sections_count;
+  uint32_t reserved;
+};
+
+struct FlatSectionEntry {
+  uint32_t id;
+  // Size of one record; a reader built with another layout of the record
+  // type refuses the section instead of misreading it.
+  uint32_t record_size;
+  uint64_t offset;
+  uint64_t size;
+};
+
+class FlatWriter {
+public:
+  static const size_t SECTION_ALIGNMENT = 64;
+
+  template <typename T>
+  void add(FlatSection id, const T *data, size_t count);
+  template <typename T> void add(FlatSection id, const FlatArray<T> &array);
+  template <typename T> void add(FlatSection id, const std::vector<T> &array);
+
+  void write(std::ostream &out) const;
+
+private:
+  struct Section {
+    FlatSectionEntry entry;
+    std::string data;
+  };
+
+  std::vector<Section> sections_;
+};
+
+class FlatReader {
+public:
+  // Returns false if the file is not a flat base; throws if it is one that
+  // this build cannot read.
+  bool open(const std::string &path);
+
+  // The section as a view into the mapping, empty if the base has no such
+  // section. The reader must outlive the returned array.
+  template <typename T> FlatArray<T> get(FlatSection id) const;
+
+private:
+  const FlatSectionEntry *find_section(FlatSection id) const;
+
+  MappedFile file_;
+  std::vector<FlatSectionEntry> sections_;
+};
+
+template <typename T>
+void FlatWriter::add(FlatSection id, const T *data, size_t count) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "flat base sections hold trivially copyable records only");
+
+  Section section;
+
+  section.entry = {static_cast<uint32_t>(id), static_cast<uint32_t>(sizeof(T)),
+                   0, count * sizeof(T)};
+  section.data.assign(reinterpret_cast<const char *>(data), count * sizeof(T));
+
+  sections_.push_back(std::move(section));
+}
+
+template <typename T>
+void FlatWriter::add(FlatSection id, const FlatArray<T> &array) {
+  add(id, array.data(), array.size());
+}
+
+template <typename T>
+void FlatWriter::add(FlatSection id, const std::vector<T> &array) {
+  add(id, array.data(), array.size());
+}
+
+template <typename T> FlatArray<T> FlatReader::get(FlatSection id) const {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "flat base sections hold trivially copyable records only");
+
+  const FlatSectionEntry *section = find_section(id);
+
+  if (!section) {
+    return {};
+  }
+
+  if (section->record_size != sizeof(T) || section->size % sizeof(T) != 0) {
+    throw std::runtime_error("flat base section has an unexpected layout");
+  }
+
+  const char *data = file_.get_data().data() + section->offset;
+
+  if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+    throw std::runtime_error("flat base section is misaligned");
+  }
+
+  return FlatArray<T>::view(reinterpret_cast<const T *>(data),
+                            section->size / sizeof(T));
+}
+
+} // end namespace domain
\ No newline at end of file
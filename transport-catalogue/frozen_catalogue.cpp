@@ -0,0 +1,614 @@
+#include "frozen_catalogue.h"
+#include "transport_catalogue.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace transport_catalogue {
+
+using domain::FlatSection;
+
+namespace {
+
+// Network statistics as stored in a flat base.
+struct FlatNetworkCounts {
+  uint64_t stop_count;
+  uint64_t bus_count;
+  uint64_t total_route_length;
+  uint64_t curvature_count;
+  double total_curvature;
+};
+
+struct FlatRankEntry {
+  NameRef name;
+  uint64_t value;
+};
+
+} // end namespace
+
+NameRef FrozenCatalogue::add_name(std::vector<char> &names,
+                                  std::string_view name) {
+  NameRef result{static_cast<uint32_t>(names.size()),
+                 static_cast<uint32_t>(name.size())};
+
+  names.insert(names.end(), name.begin(), name.end());
+  return result;
+}
+
+FrozenCatalogue::FrozenCatalogue(const TransportCatalogue &catalogue) {
+  const auto &stops = catalogue.get_stops();
+  const auto &buses = catalogue.get_buses();
+
+  size_t names_size = 0;
+  for (const Stop &stop : stops) {
+    names_size += stop.name.size();
+  }
+  for (const Bus &bus : buses) {
+    names_size += bus.name.size();
+  }
+
+  std::vector<char> names;
+  names.reserve(names_size);
+
+  std::unordered_map<const Stop *, uint32_t> stop_to_id;
+  std::unordered_map<const Bus *, uint32_t> bus_to_id;
+  stop_to_id.reserve(stops.size());
+  bus_to_id.reserve(buses.size());
+
+  std::vector<FrozenStop> frozen_stops;
+  frozen_stops.reserve(stops.size());
+  for (const Stop &stop : stops) {
+    FrozenStop frozen_stop;
+
+    frozen_stop.name = add_name(names, stop.name);
+    frozen_stop.coordinates = {stop.latitude, stop.longitude};
+
+    stop_to_id[&stop] = static_cast<uint32_t>(frozen_stops.size());
+    frozen_stops.push_back(frozen_stop);
+  }
+
+  std::vector<FrozenBus> frozen_buses;
+  std::vector<uint32_t> bus_stop_ids;
+  frozen_buses.reserve(buses.size());
+  for (const Bus &bus : buses) {
+    FrozenBus frozen_bus;
+
+    frozen_bus.name = add_name(names, bus.name);
+    frozen_bus.is_roundtrip = bus.is_roundtrip;
+
+    frozen_bus.stops_begin = static_cast<uint32_t>(bus_stop_ids.size());
+    for (const Stop *stop : bus.stops) {
+      bus_stop_ids.push_back(stop_to_id.at(stop));
+    }
+    frozen_bus.stops_end = static_cast<uint32_t>(bus_stop_ids.size());
+
+    std::vector<uint32_t> unique_stops(
+        bus_stop_ids.begin() + frozen_bus.stops_begin, bus_stop_ids.end());
+    std::sort(unique_stops.begin(), unique_stops.end());
+    frozen_bus.unique_stops = static_cast<uint32_t>(
+        std::unique(unique_stops.begin(), unique_stops.end()) -
+        unique_stops.begin());
+
+    bus_to_id[&bus] = static_cast<uint32_t>(frozen_buses.size());
+    frozen_buses.push_back(frozen_bus);
+  }
+
+  names_ = std::move(names);
+  bus_stop_ids_ = std::move(bus_stop_ids);
+
+  std::vector<uint32_t> buses_by_name(frozen_buses.size());
+  std::iota(buses_by_name.begin(), buses_by_name.end(), 0);
+  std::sort(buses_by_name.begin(), buses_by_name.end(),
+            [this, &frozen_buses](uint32_t lhs, uint32_t rhs) {
+              return get_name(frozen_buses[lhs].name) <
+                     get_name(frozen_buses[rhs].name);
+            });
+
+  std::vector<uint32_t> bus_ranks(frozen_buses.size());
+  for (uint32_t rank = 0; rank < buses_by_name.size(); ++rank) {
+    bus_ranks[buses_by_name[rank]] = rank;
+  }
+  bus_ranks_ = std::move(bus_ranks);
+
+  std::vector<uint32_t> stop_bus_ids;
+  size_t stop_id = 0;
+  for (const Stop &stop : stops) {
+    FrozenStop &frozen_stop = frozen_stops[stop_id++];
+    frozen_stop.buses_begin = static_cast<uint32_t>(stop_bus_ids.size());
+
+    for (const Bus *bus : stop.buses) {
+      stop_bus_ids.push_back(bus_to_id.at(bus));
+    }
+
+    auto first = stop_bus_ids.begin() + frozen_stop.buses_begin;
+    std::sort(first, stop_bus_ids.end(), [this](uint32_t lhs, uint32_t rhs) {
+      return bus_ranks_[lhs] < bus_ranks_[rhs];
+    });
+    stop_bus_ids.erase(std::unique(first, stop_bus_ids.end()),
+                       stop_bus_ids.end());
+
+    frozen_stop.buses_end = static_cast<uint32_t>(stop_bus_ids.size());
+  }
+
+  stops_ = std::move(frozen_stops);
+  stop_bus_ids_ = std::move(stop_bus_ids);
+
+  std::vector<domain::DistanceTable::Entry> distances;
+  for (const Stop &stop : stops) {
+    // The table makes its own copies of the way back.
+    for (const auto &[neighbour, distance, is_given] : stop.distances) {
+      if (is_given) {
+        distances.push_back({stop_to_id.at(&stop), stop_to_id.at(neighbour),
+                             static_cast<uint32_t>(distance)});
+      }
+    }
+  }
+  distances_.build(stops_.size(), std::move(distances));
+
+  init_segment_lengths(frozen_buses);
+  buses_ = std::move(frozen_buses);
+
+  init_stop_positions();
+
+  if (!catalogue.get_stop_index().empty() &&
+      !catalogue.get_bus_index().empty()) {
+    stop_index_ = catalogue.get_stop_index();
+    bus_index_ = catalogue.get_bus_index();
+
+  } else {
+    std::vector<std::string_view> names;
+
+    for (const FrozenStop &stop : stops_) {
+      names.push_back(get_name(stop.name));
+    }
+    stop_index_.build(names);
+
+    names.clear();
+    for (const FrozenBus &bus : buses_) {
+      names.push_back(get_name(bus.name));
+    }
+    bus_index_.build(names);
+  }
+
+  if (!catalogue.get_stop_trie().empty()) {
+    stop_trie_ = catalogue.get_stop_trie();
+
+  } else {
+    std::vector<std::string_view> names;
+
+    for (const FrozenStop &stop : stops_) {
+      names.push_back(get_name(stop.name));
+    }
+    stop_trie_.build(names);
+  }
+
+  if (!catalogue.get_spatial_index().empty() || stops_.empty()) {
+    spatial_index_ = catalogue.get_spatial_index();
+
+  } else {
+    std::vector<geo::Coordinates> points;
+
+    for (const FrozenStop &stop : stops_) {
+      points.push_back(stop.coordinates);
+    }
+    spatial_index_.build(points);
+  }
+
+  // The names of the ranked entries point into the source catalogue.
+  network_stats_ = catalogue.get_network_stats();
+
+  std::vector<domain::NetworkStats::Entry> busiest_stops;
+  std::vector<domain::NetworkStats::Entry> longest_buses;
+
+  for (const auto &entry : network_stats_.get_busiest_stops()) {
+    busiest_stops.push_back(
+        {get_name(get_stop(entry.name)->name), entry.value});
+  }
+  for (const auto &entry : network_stats_.get_longest_buses()) {
+    longest_buses.push_back({get_name(get_bus(entry.name)->name), entry.value});
+  }
+
+  network_stats_.set_rankings(std::move(busiest_stops),
+                              std::move(longest_buses));
+}
+
+FrozenCatalogue::FrozenCatalogue(const domain::FlatReader &reader)
+    : names_(reader.get<char>(FlatSection::NAMES)),
+      stops_(reader.get<FrozenStop>(FlatSection::STOPS)),
+      buses_(reader.get<FrozenBus>(FlatSection::BUSES)),
+      bus_stop_ids_(reader.get<uint32_t>(FlatSection::BUS_STOP_IDS)),
+      bus_ranks_(reader.get<uint32_t>(FlatSection::BUS_RANKS)),
+      stop_bus_ids_(reader.get<uint32_t>(FlatSection::STOP_BUS_IDS)),
+      stop_first_positions_(
+          reader.get<uint32_t>(FlatSection::STOP_FIRST_POSITIONS)),
+      stop_last_positions_(
+          reader.get<uint32_t>(FlatSection::STOP_LAST_POSITIONS)),
+      road_lengths_(reader.get<size_t>(FlatSection::ROAD_LENGTHS)),
+      road_back_lengths_(reader.get<size_t>(FlatSection::ROAD_BACK_LENGTHS)),
+      geo_lengths_(reader.get<double>(FlatSection::GEO_LENGTHS)),
+      distances_(reader.get<uint32_t>(FlatSection::DISTANCE_OFFSETS),
+                 reader.get<uint32_t>(FlatSection::DISTANCE_NEIGHBOURS),
+                 reader.get<uint32_t>(FlatSection::DISTANCES)),
+      stop_trie_(reader.get<char>(FlatSection::STOP_TRIE_LABELS),
+                 reader.get<uint32_t>(FlatSection::STOP_TRIE_CHILDREN_BEGIN),
+                 reader.get<uint32_t>(FlatSection::STOP_TRIE_VALUES)),
+      spatial_index_(
+          reader.get<uint32_t>(FlatSection::SPATIAL_INDEX_IDS),
+          reader.get<geo::BoundingBox>(FlatSection::SPATIAL_INDEX_BOXES)) {
+  const auto seeds = reader.get<uint64_t>(FlatSection::INDEX_SEEDS);
+
+  if (seeds.size() == 2) {
+    stop_index_ = domain::NameIndex(
+        seeds[0], reader.get<uint32_t>(FlatSection::STOP_INDEX_DISPLACEMENTS),
+        reader.get<uint32_t>(FlatSection::STOP_INDEX_SLOTS));
+    bus_index_ = domain::NameIndex(
+        seeds[1], reader.get<uint32_t>(FlatSection::BUS_INDEX_DISPLACEMENTS),
+        reader.get<uint32_t>(FlatSection::BUS_INDEX_SLOTS));
+  }
+
+  const auto counts =
+      reader.get<FlatNetworkCounts>(FlatSection::NETWORK_COUNTS);
+
+  if (counts.size() == 1) {
+    network_stats_.set_counts(counts[0].stop_count, counts[0].bus_count,
+                              counts[0].total_route_length,
+                              counts[0].total_curvature,
+                              counts[0].curvature_count);
+  }
+
+  std::vector<domain::NetworkStats::Entry> busiest_stops;
+  std::vector<domain::NetworkStats::Entry> longest_buses;
+
+  for (const auto &entry :
+       reader.get<FlatRankEntry>(FlatSection::BUSIEST_STOPS)) {
+    busiest_stops.push_back({get_name(entry.name), entry.value});
+  }
+  for (const auto &entry :
+       reader.get<FlatRankEntry>(FlatSection::LONGEST_BUSES)) {
+    longest_buses.push_back({get_name(entry.name), entry.value});
+  }
+
+  const auto stop_bus_counts =
+      reader.get<uint64_t>(FlatSection::STOP_BUS_COUNT_HISTOGRAM);
+  const auto route_lengths =
+      reader.get<uint64_t>(FlatSection::ROUTE_LENGTH_HISTOGRAM);
+
+  network_stats_.set_rankings(std::move(busiest_stops),
+                              std::move(longest_buses));
+  network_stats_.set_histograms(
+      {stop_bus_counts.begin(), stop_bus_counts.end()},
+      {route_lengths.begin(), route_lengths.end()});
+}
+
+void FrozenCatalogue::save(domain::FlatWriter &writer) const {
+  writer.add(FlatSection::NAMES, names_);
+  writer.add(FlatSection::STOPS, stops_);
+  writer.add(FlatSection::BUSES, buses_);
+  writer.add(FlatSection::BUS_STOP_IDS, bus_stop_ids_);
+  writer.add(FlatSection::BUS_RANKS, bus_ranks_);
+  writer.add(FlatSection::STOP_BUS_IDS, stop_bus_ids_);
+  writer.add(FlatSection::STOP_FIRST_POSITIONS, stop_first_positions_);
+  writer.add(FlatSection::STOP_LAST_POSITIONS, stop_last_positions_);
+  writer.add(FlatSection::ROAD_LENGTHS, road_lengths_);
+  writer.add(FlatSection::ROAD_BACK_LENGTHS, road_back_lengths_);
+  writer.add(FlatSection::GEO_LENGTHS, geo_lengths_);
+
+  writer.add(FlatSection::DISTANCE_OFFSETS, distances_.get_offsets());
+  writer.add(FlatSection::DISTANCE_NEIGHBOURS, distances_.get_neighbours());
+  writer.add(FlatSection::DISTANCES, distances_.get_distances());
+
+  const std::vector<uint64_t> seeds{stop_index_.get_seed(),
+                                    bus_index_.get_seed()};
+  writer.add(FlatSection::INDEX_SEEDS, seeds);
+  writer.add(FlatSection::STOP_INDEX_DISPLACEMENTS,
+             stop_index_.get_displacements());
+  writer.add(FlatSection::STOP_INDEX_SLOTS, stop_index_.get_slots());
+  writer.add(FlatSection::BUS_INDEX_DISPLACEMENTS,
+             bus_index_.get_displacements());
+  writer.add(FlatSection::BUS_INDEX_SLOTS, bus_index_.get_slots());
+
+  writer.add(FlatSection::STOP_TRIE_LABELS, stop_trie_.get_labels());
+  writer.add(FlatSection::STOP_TRIE_CHILDREN_BEGIN,
+             stop_trie_.get_children_begin());
+  writer.add(FlatSection::STOP_TRIE_VALUES, stop_trie_.get_values());
+
+  writer.add(FlatSection::SPATIAL_INDEX_IDS, spatial_index_.get_ids());
+  writer.add(FlatSection::SPATIAL_INDEX_BOXES, spatial_index_.get_boxes());
+
+  const std::vector<FlatNetworkCounts> counts{
+      {network_stats_.get_stop_count(), network_stats_.get_bus_count(),
+       network_stats_.get_total_route_length(),
+       network_stats_.get_curvature_count(),
+       network_stats_.get_total_curvature()}};
+  writer.add(FlatSection::NETWORK_COUNTS, counts);
+
+  std::vector<FlatRankEntry> busiest_stops;
+  std::vector<FlatRankEntry> longest_buses;
+
+  for (const auto &entry : network_stats_.get_busiest_stops()) {
+    busiest_stops.push_back({get_stop(entry.name)->name, entry.value});
+  }
+  for (const auto &entry : network_stats_.get_longest_buses()) {
+    longest_buses.push_back({get_bus(entry.name)->name, entry.value});
+  }
+
+  writer.add(FlatSection::BUSIEST_STOPS, busiest_stops);
+  writer.add(FlatSection::LONGEST_BUSES, longest_buses);
+  writer.add(FlatSection::STOP_BUS_COUNT_HISTOGRAM,
+             network_stats_.get_stop_bus_count_histogram());
+  writer.add(FlatSection::ROUTE_LENGTH_HISTOGRAM,
+             network_stats_.get_route_length_histogram());
+}
+
+void FrozenCatalogue::init_stop_positions() {
+  std::vector<uint32_t> first_positions(stop_bus_ids_.size(), 0);
+  std::vector<uint32_t> last_positions(stop_bus_ids_.size(), 0);
+
+  for (const FrozenBus &bus : buses_) {
+    const uint32_t bus_id = get_bus_id(bus);
+    const RouteView bus_stops = get_bus_stops(bus);
+
+    for (uint32_t pos = static_cast<uint32_t>(bus_stops.size()); pos > 0;
+         --pos) {
+      const size_t entry = find_stop_bus(stops_[bus_stops[pos - 1]], bus_id);
+
+      if (last_positions[entry] == 0) {
+        last_positions[entry] = pos;
+      }
+      first_positions[entry] = pos;
+    }
+  }
+
+  stop_first_positions_ = std::move(first_positions);
+  stop_last_positions_ = std::move(last_positions);
+}
+
+size_t FrozenCatalogue::find_stop_bus(const FrozenStop &stop,
+                                      uint32_t bus_id) const {
+  const auto first = stop_bus_ids_.begin() + stop.buses_begin;
+  const auto last = stop_bus_ids_.begin() + stop.buses_end;
+
+  return std::lower_bound(first, last, bus_id,
+                          [this](uint32_t lhs, uint32_t rhs) {
+                            return bus_ranks_[lhs] < bus_ranks_[rhs];
+                          }) -
+         stop_bus_ids_.begin();
+}
+
+void FrozenCatalogue::init_segment_lengths(std::vector<FrozenBus> &buses) {
+  geo::TrigTable trig_table;
+  for (const FrozenStop &stop : stops_) {
+    trig_table.add(stop.coordinates);
+  }
+
+  std::vector<size_t> road_lengths(bus_stop_ids_.size(), 0);
+  std::vector<size_t> road_back_lengths(bus_stop_ids_.size(), 0);
+  std::vector<double> geo_lengths(bus_stop_ids_.size(), 0.);
+
+  std::vector<double> segment_lengths;
+  for (const FrozenBus &bus : buses) {
+    if (bus.stops_end - bus.stops_begin < 2) {
+      continue;
+    }
+
+    const uint32_t *bus_stops = bus_stop_ids_.data() + bus.stops_begin;
+    const size_t segments_count = bus.stops_end - bus.stops_begin - 1;
+
+    segment_lengths.resize(segments_count);
+    trig_table.compute_distances(bus_stops, bus_stops + 1,
+                                 segment_lengths.data(), segments_count);
+
+    for (size_t i = 0; i < segments_count; ++i) {
+      const size_t pos = bus.stops_begin + i;
+
+      road_lengths[pos + 1] =
+          road_lengths[pos] + get_distance(bus_stops[i], bus_stops[i + 1]);
+      geo_lengths[pos + 1] = geo_lengths[pos] + segment_lengths[i];
+    }
+
+    if (!bus.is_roundtrip) {
+      for (size_t i = segments_count; i > 0; --i) {
+        const size_t pos = bus.stops_begin + i;
+
+        road_back_lengths[pos - 1] =
+            road_back_lengths[pos] +
+            get_distance(bus_stops[i], bus_stops[i - 1]);
+      }
+    }
+  }
+
+  road_lengths_ = std::move(road_lengths);
+  road_back_lengths_ = std::move(road_back_lengths);
+  geo_lengths_ = std::move(geo_lengths);
+
+  for (FrozenBus &bus : buses) {
+    if (bus.stops_end - bus.stops_begin < 2) {
+      continue;
+    }
+
+    const size_t last = get_bus_stops(bus).size() - 1;
+    bus.route_length = get_road_length(bus, last);
+    bus.geo_length = get_geo_length(bus, last);
+  }
+}
+
+const FrozenStop *FrozenCatalogue::get_stop(std::string_view stop_name) const {
+  auto id = stop_index_.find(stop_name);
+
+  if (id && *id < stops_.size() && get_name(stops_[*id].name) == stop_name) {
+    return &stops_[*id];
+  }
+
+  return nullptr;
+}
+
+const FrozenBus *FrozenCatalogue::get_bus(std::string_view bus_name) const {
+  auto id = bus_index_.find(bus_name);
+
+  if (id && *id < buses_.size() && get_name(buses_[*id].name) == bus_name) {
+    return &buses_[*id];
+  }
+
+  return nullptr;
+}
+
+std::string_view FrozenCatalogue::get_name(NameRef name) const {
+  return {names_.data() + name.offset, name.size};
+}
+
+const domain::FlatArray<FrozenStop> &FrozenCatalogue::get_stops() const {
+  return stops_;
+}
+
+const domain::FlatArray<FrozenBus> &FrozenCatalogue::get_buses() const {
+  return buses_;
+}
+
+uint32_t FrozenCatalogue::get_stop_id(const FrozenStop &stop) const {
+  return static_cast<uint32_t>(&stop - stops_.data());
+}
+
+uint32_t FrozenCatalogue::get_bus_id(const FrozenBus &bus) const {
+  return static_cast<uint32_t>(&bus - buses_.data());
+}
+
+RouteView FrozenCatalogue::get_bus_stops(const FrozenBus &bus) const {
+  return {bus_stop_ids_.data() + bus.stops_begin,
+          bus.stops_end - bus.stops_begin, bus.is_roundtrip};
+}
+
+FrozenCatalogue::IdRange
+FrozenCatalogue::get_stop_buses(const FrozenStop &stop) const {
+  return {stop_bus_ids_.begin() + stop.buses_begin,
+          stop_bus_ids_.begin() + stop.buses_end};
+}
+
+std::vector<const FrozenBus *>
+FrozenCatalogue::find_direct_buses(const FrozenStop &from,
+                                   const FrozenStop &to) const {
+  std::vector<const FrozenBus *> result;
+
+  size_t lhs = from.buses_begin;
+  size_t rhs = to.buses_begin;
+
+  while (lhs < from.buses_end && rhs < to.buses_end) {
+    const uint32_t lhs_rank = bus_ranks_[stop_bus_ids_[lhs]];
+    const uint32_t rhs_rank = bus_ranks_[stop_bus_ids_[rhs]];
+
+    if (lhs_rank < rhs_rank) {
+      ++lhs;
+
+    } else if (rhs_rank < lhs_rank) {
+      ++rhs;
+
+    } else {
+      if (stop_first_positions_[lhs] < stop_last_positions_[rhs]) {
+        result.push_back(&buses_[stop_bus_ids_[lhs]]);
+      }
+
+      ++lhs;
+      ++rhs;
+    }
+  }
+
+  return result;
+}
+
+std::vector<const FrozenStop *>
+FrozenCatalogue::find_stops_by_name(std::string_view query, size_t max_edits,
+                                    size_t limit) const {
+  std::vector<const FrozenStop *> result;
+
+  const auto stop_ids = max_edits == 0
+                            ? stop_trie_.find_prefix(query, limit)
+                            : stop_trie_.find_similar(query, max_edits, limit);
+
+  for (uint32_t stop_id : stop_ids) {
+    result.push_back(&stops_[stop_id]);
+  }
+
+  return result;
+}
+
+std::vector<std::pair<const FrozenStop *, double>>
+FrozenCatalogue::find_nearest_stops(geo::Coordinates point,
+                                    size_t count) const {
+  std::vector<std::pair<const FrozenStop *, double>> result;
+
+  for (auto [stop_id, distance] : spatial_index_.find_nearest(point, count)) {
+    result.emplace_back(&stops_[stop_id], distance);
+  }
+
+  return result;
+}
+
+std::vector<const FrozenStop *>
+FrozenCatalogue::find_stops_in_area(const geo::BoundingBox &area) const {
+  std::vector<const FrozenStop *> result;
+
+  for (uint32_t stop_id : spatial_index_.find_in_area(area)) {
+    result.push_back(&stops_[stop_id]);
+  }
+
+  std::sort(result.begin(), result.end(),
+            [this](const FrozenStop *lhs, const FrozenStop *rhs) {
+              return get_name(lhs->name) < get_name(rhs->name);
+            });
+
+  return result;
+}
+
+size_t FrozenCatalogue::get_distance(uint32_t from, uint32_t to) const {
+  return distances_.find(from, to);
+}
+
+const domain::DistanceTable &FrozenCatalogue::get_distance_table() const {
+  return distances_;
+}
+
+size_t FrozenCatalogue::get_road_length(const FrozenBus &bus,
+                                        size_t pos) const {
+  const size_t stored_count = bus.stops_end - bus.stops_begin;
+
+  if (pos < stored_count) {
+    return road_lengths_[bus.stops_begin + pos];
+  }
+
+  const size_t back_pos = 2 * stored_count - 2 - pos;
+  return road_lengths_[bus.stops_end - 1] +
+         road_back_lengths_[bus.stops_begin + back_pos];
+}
+
+double FrozenCatalogue::get_geo_length(const FrozenBus &bus,
+                                       size_t pos) const {
+  const size_t stored_count = bus.stops_end - bus.stops_begin;
+
+  if (pos < stored_count) {
+    return geo_lengths_[bus.stops_begin + pos];
+  }
+
+  const size_t back_pos = 2 * stored_count - 2 - pos;
+  const double way_out = geo_lengths_[bus.stops_end - 1];
+  return 2 * way_out - geo_lengths_[bus.stops_begin + back_pos];
+}
+
+size_t FrozenCatalogue::get_road_length(const FrozenBus &bus, size_t from,
+                                        size_t to) const {
+  return get_road_length(bus, to) - get_road_length(bus, from);
+}
+
+double FrozenCatalogue::get_geo_length(const FrozenBus &bus, size_t from,
+                                       size_t to) const {
+  return get_geo_length(bus, to) - get_geo_length(bus, from);
+}
+
+double FrozenCatalogue::get_curvature(const FrozenBus &bus) const {
+  return double(bus.route_length / bus.geo_length);
+}
+
+const domain::NetworkStats &FrozenCatalogue::get_network_stats() const {
+  return network_stats_;
+}
+
+} // end namespace transport_catalogue
\ No newline at end of file
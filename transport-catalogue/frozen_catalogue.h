@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "distance_table.h"
+#include "domain.h"
+#include "flat_array.h"
+#include "flat_base.h"
+#include "geo.h"
+#include "name_index.h"
+#include "name_trie.h"
+#include "network_stats.h"
+#include "ranges.h"
+#include "spatial_index.h"
+
+namespace transport_catalogue {
+
+class TransportCatalogue;
+
+// Name of a stop or a bus as a range of the catalogue's name blob, resolved
+// with FrozenCatalogue::get_name. The records hold no pointers, so they can
+// be written to a flat base and used from it as they are.
+struct NameRef {
+  uint32_t offset = 0;
+  uint32_t size = 0;
+};
+
+struct FrozenStop {
+  NameRef name;
+  geo::Coordinates coordinates;
+
+  uint32_t buses_begin = 0;
+  uint32_t buses_end = 0;
+};
+
+struct FrozenBus {
+  NameRef name;
+
+  // Stops as given in the input: a non-roundtrip route keeps only the way
+  // out, use FrozenCatalogue::get_bus_stops for the full traversal.
+  uint32_t stops_begin = 0;
+  uint32_t stops_end = 0;
+
+  bool is_roundtrip = false;
+  // The padding after is_roundtrip spelled out, so that a flat base gets
+  // zeros there rather than whatever the memory held.
+  uint8_t reserved[3] = {};
+  uint32_t unique_stops = 0;
+  size_t route_length = 0;
+  double geo_length = 0.;
+};
+
+// Stops of a bus in travel order. The view reads a non-roundtrip route
+// forward and then back to its first stop, so the stored sequence A B C
+// is seen as A B C B A.
+class RouteView {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint32_t *;
+    using reference = uint32_t;
+
+    Iterator(const RouteView *view, size_t pos) : view_(view), pos_(pos) {}
+
+    uint32_t operator*() const { return (*view_)[pos_]; }
+
+    Iterator &operator++() {
+      ++pos_;
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const { return pos_ == other.pos_; }
+    bool operator!=(const Iterator &other) const { return pos_ != other.pos_; }
+
+  private:
+    const RouteView *view_;
+    size_t pos_;
+  };
+
+  RouteView(const uint32_t *stops, size_t stored_count, bool is_roundtrip)
+      : stops_(stops), stored_count_(stored_count),
+        is_roundtrip_(is_roundtrip) {}
+
+  size_t size() const {
+    if (is_roundtrip_ || stored_count_ == 0) {
+      return stored_count_;
+    }
+
+    return 2 * stored_count_ - 1;
+  }
+
+  uint32_t operator[](size_t pos) const {
+    return pos < stored_count_ ? stops_[pos]
+                               : stops_[2 * stored_count_ - 2 - pos];
+  }
+
+  Iterator begin() const { return {this, 0}; }
+  Iterator end() const { return {this, size()}; }
+
+private:
+  const uint32_t *stops_;
+  size_t stored_count_;
+  bool is_roundtrip_;
+};
+
+// Immutable snapshot of a TransportCatalogue. All data lives in a few flat
+// arrays indexed by stop and bus ids (the ids are the positions in the source
+// catalogue), every derived value is computed once in the constructor and the
+// whole API is const, so one instance can be shared by any number of reader
+// threads without locks. The arrays are saved to a flat base as they are and
+// a catalogue opened from one reads them straight from the mapping.
+class FrozenCatalogue {
+public:
+  using IdRange = ranges::Range<const uint32_t *>;
+
+  FrozenCatalogue() = default;
+  explicit FrozenCatalogue(const TransportCatalogue &catalogue);
+  // Uses the arrays of a flat base in place; the reader must outlive the
+  // catalogue.
+  explicit FrozenCatalogue(const domain::FlatReader &reader);
+
+  FrozenCatalogue(const FrozenCatalogue &) = delete;
+  FrozenCatalogue &operator=(const FrozenCatalogue &) = delete;
+  FrozenCatalogue(FrozenCatalogue &&) = default;
+  FrozenCatalogue &operator=(FrozenCatalogue &&) = default;
+
+  void save(domain::FlatWriter &writer) const;
+
+  const FrozenStop *get_stop(std::string_view stop_name) const;
+  const FrozenBus *get_bus(std::string_view bus_name) const;
+
+  std::string_view get_name(NameRef name) const;
+
+  const domain::FlatArray<FrozenStop> &get_stops() const;
+  const domain::FlatArray<FrozenBus> &get_buses() const;
+
+  uint32_t get_stop_id(const FrozenStop &stop) const;
+  uint32_t get_bus_id(const FrozenBus &bus) const;
+
+  RouteView get_bus_stops(const FrozenBus &bus) const;
+  IdRange get_stop_buses(const FrozenStop &stop) const;
+
+  // Buses that go from one stop to the other without a transfer, sorted by
+  // name: both stops are on the bus and from is visited before to.
+  std::vector<const FrozenBus *> find_direct_buses(const FrozenStop &from,
+                                                   const FrozenStop &to) const;
+
+  // Stops whose names start with query or, if max_edits is not zero, are
+  // within max_edits edits from it; at most limit of them.
+  std::vector<const FrozenStop *> find_stops_by_name(std::string_view query,
+                                                     size_t max_edits,
+                                                     size_t limit) const;
+
+  std::vector<std::pair<const FrozenStop *, double>>
+  find_nearest_stops(geo::Coordinates point, size_t count) const;
+  std::vector<const FrozenStop *>
+  find_stops_in_area(const geo::BoundingBox &area) const;
+
+  size_t get_distance(uint32_t from, uint32_t to) const;
+  const domain::DistanceTable &get_distance_table() const;
+
+  // Lengths of the part of the bus route between positions from and to of
+  // its traversal (from <= to < get_bus_stops(bus).size()), taken from
+  // per-bus prefix sums in O(1).
+  size_t get_road_length(const FrozenBus &bus, size_t from, size_t to) const;
+  double get_geo_length(const FrozenBus &bus, size_t from, size_t to) const;
+  double get_curvature(const FrozenBus &bus) const;
+
+  const domain::NetworkStats &get_network_stats() const;
+
+private:
+  static NameRef add_name(std::vector<char> &names, std::string_view name);
+
+  void init_stop_positions();
+  void init_segment_lengths(std::vector<FrozenBus> &buses);
+
+  size_t find_stop_bus(const FrozenStop &stop, uint32_t bus_id) const;
+
+  size_t get_road_length(const FrozenBus &bus, size_t pos) const;
+  double get_geo_length(const FrozenBus &bus, size_t pos) const;
+
+  domain::FlatArray<char> names_;
+
+  domain::FlatArray<FrozenStop> stops_;
+  domain::FlatArray<FrozenBus> buses_;
+
+  domain::FlatArray<uint32_t> bus_stop_ids_;
+  // Buses of every stop ordered by name, i.e. by bus_ranks_. For each entry
+  // the first and last traversal positions of the stop on that bus are kept,
+  // counted from 1.
+  domain::FlatArray<uint32_t> bus_ranks_;
+  domain::FlatArray<uint32_t> stop_bus_ids_;
+  domain::FlatArray<uint32_t> stop_first_positions_;
+  domain::FlatArray<uint32_t> stop_last_positions_;
+
+  // Prefix sums along bus_stop_ids_: the length of a bus route from its first
+  // stop to the stop at the same position. For the way back of a
+  // non-roundtrip route road_back_lengths_ holds the length from the last
+  // stored stop back to the stop at the same position; the geographic
+  // length is symmetric and needs no second table.
+  domain::FlatArray<size_t> road_lengths_;
+  domain::FlatArray<size_t> road_back_lengths_;
+  domain::FlatArray<double> geo_lengths_;
+
+  domain::DistanceTable distances_;
+
+  domain::NameIndex stop_index_;
+  domain::NameIndex bus_index_;
+
+  domain::NameTrie stop_trie_;
+  domain::SpatialIndex spatial_index_;
+
+  domain::NetworkStats network_stats_;
+};
+
+} // end namespace transport_catalogue
\ No newline at end of file
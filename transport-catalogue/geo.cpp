@@ -1,6 +1,7 @@
 #define _USE_MATH_DEFINES
 #include "geo.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace geo {
@@ -19,4 +20,90 @@ double compute_distance(Coordinates start, Coordinates end) {
   }
 }
 
+void compute_distances(const double *sin_latitude_a,
+                       const double *cos_latitude_a,
+                       const double *longitude_a,
+                       const double *sin_latitude_b,
+                       const double *cos_latitude_b,
+                       const double *longitude_b, double *result,
+                       size_t count) {
+  using namespace std;
+
+  for (size_t i = 0; i < count; ++i) {
+    const double cos_angle =
+        sin_latitude_a[i] * sin_latitude_b[i] +
+        cos_latitude_a[i] * cos_latitude_b[i] *
+            cos(longitude_a[i] - longitude_b[i]);
+
+    const bool coincident = sin_latitude_a[i] == sin_latitude_b[i] &&
+                            cos_latitude_a[i] == cos_latitude_b[i] &&
+                            longitude_a[i] == longitude_b[i];
+
+    result[i] = coincident
+                    ? 0.
+                    : acos(min(max(cos_angle, -1.), 1.)) * EARTH_RADIUS;
+  }
+}
+
+TrigTable::TrigTable(const std::vector<Coordinates> &points) {
+  sin_latitude_.reserve(points.size());
+  cos_latitude_.reserve(points.size());
+  longitude_.reserve(points.size());
+
+  for (const auto &point : points) {
+    add(point);
+  }
+}
+
+void TrigTable::add(Coordinates point) {
+  const double dr = PI / 180.;
+
+  sin_latitude_.push_back(std::sin(point.latitude * dr));
+  cos_latitude_.push_back(std::cos(point.latitude * dr));
+  longitude_.push_back(point.longitude * dr);
+}
+
+size_t TrigTable::size() const { return longitude_.size(); }
+
+void TrigTable::compute_distances(const uint32_t *from, const uint32_t *to,
+                                  double *result, size_t count) const {
+  static const size_t BATCH_SIZE = 64;
+
+  double sin_latitude_a[BATCH_SIZE];
+  double cos_latitude_a[BATCH_SIZE];
+  double longitude_a[BATCH_SIZE];
+  double sin_latitude_b[BATCH_SIZE];
+  double cos_latitude_b[BATCH_SIZE];
+  double longitude_b[BATCH_SIZE];
+
+  for (size_t first = 0; first < count; first += BATCH_SIZE) {
+    const size_t batch = std::min(BATCH_SIZE, count - first);
+
+    for (size_t i = 0; i < batch; ++i) {
+      sin_latitude_a[i] = sin_latitude_[from[first + i]];
+      cos_latitude_a[i] = cos_latitude_[from[first + i]];
+      longitude_a[i] = longitude_[from[first + i]];
+      sin_latitude_b[i] = sin_latitude_[to[first + i]];
+      cos_latitude_b[i] = cos_latitude_[to[first + i]];
+      longitude_b[i] = longitude_[to[first + i]];
+    }
+
+    geo::compute_distances(sin_latitude_a, cos_latitude_a, longitude_a,
+                           sin_latitude_b, cos_latitude_b, longitude_b,
+                           result + first, batch);
+  }
+}
+
+void TrigTable::compute_path_distances(double *result) const {
+  if (size() < 2) {
+    return;
+  }
+
+  // Consecutive pairs are the table shifted by one, so nothing is gathered.
+  geo::compute_distances(sin_latitude_.data(), cos_latitude_.data(),
+                         longitude_.data(), sin_latitude_.data() + 1,
+                         cos_latitude_.data() + 1, longitude_.data() + 1,
+                         result, size() - 1);
+}
+
 } // end namespace geo
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace geo {
 
@@ -16,6 +19,61 @@ struct Coordinates {
   bool operator!=(const Coordinates &other) const { return !(*this == other); }
 };
 
+struct BoundingBox {
+  double min_latitude = 0.;
+  double min_longitude = 0.;
+  double max_latitude = 0.;
+  double max_longitude = 0.;
+
+  bool contains(const Coordinates &point) const {
+    return min_latitude <= point.latitude && point.latitude <= max_latitude &&
+           min_longitude <= point.longitude &&
+           point.longitude <= max_longitude;
+  }
+  bool intersects(const BoundingBox &other) const {
+    return min_latitude <= other.max_latitude &&
+           other.min_latitude <= max_latitude &&
+           min_longitude <= other.max_longitude &&
+           other.min_longitude <= max_longitude;
+  }
+};
+
 double compute_distance(Coordinates start, Coordinates end);
 
+// Batch kernel over structure-of-arrays input: result[i] is the distance
+// between points a[i] and b[i] given their precomputed sin/cos of latitude
+// and longitude in radians. Coincident points give exactly 0, as in
+// compute_distance, instead of the small angle acos returns for a rounded
+// cosine. The loop has no branches or calls besides cos and acos, so the
+// compiler can vectorize it.
+void compute_distances(const double *sin_latitude_a,
+                       const double *cos_latitude_a,
+                       const double *longitude_a,
+                       const double *sin_latitude_b,
+                       const double *cos_latitude_b,
+                       const double *longitude_b, double *result,
+                       size_t count);
+
+// Per-point trigonometry computed once, so distances between stored points
+// cost one cos and one acos instead of five trigonometric calls.
+class TrigTable {
+public:
+  TrigTable() = default;
+  explicit TrigTable(const std::vector<Coordinates> &points);
+
+  void add(Coordinates point);
+  size_t size() const;
+
+  void compute_distances(const uint32_t *from, const uint32_t *to,
+                         double *result, size_t count) const;
+  // result[i] is the distance between points i and i + 1, so a path of
+  // size() points has size() - 1 lengths.
+  void compute_path_distances(double *result) const;
+
+private:
+  std::vector<double> sin_latitude_;
+  std::vector<double> cos_latitude_;
+  std::vector<double> longitude_;
+};
+
 } // end namespace geo
\ No newline at end of file
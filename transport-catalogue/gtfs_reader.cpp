@@ -0,0 +1,326 @@
+#include "gtfs_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace transport_catalogue {
+namespace detail {
+namespace gtfs {
+
+static double to_double(std::string_view value) {
+  // std::from_chars for double is not available everywhere yet.
+  std::string buffer(value);
+  char *end = nullptr;
+  double result = std::strtod(buffer.c_str(), &end);
+
+  return end == buffer.c_str() ? std::nan("") : result;
+}
+
+static int to_int(std::string_view value) {
+  int result = 0;
+  std::from_chars(value.data(), value.data() + value.size(), result);
+
+  return result;
+}
+
+// Makes a name unique with the GTFS id of its entity, and then with a
+// counter if even that is taken, e.g. by an entity literally named so.
+template <typename IsTaken>
+static std::string make_unique_name(std::string name, std::string_view id,
+                                    IsTaken is_taken) {
+  if (!name.empty() && !is_taken(name)) {
+    return name;
+  }
+
+  name += " (";
+  name += id;
+  name += ')';
+
+  std::string unique_name = name;
+  for (int counter = 2; is_taken(unique_name); ++counter) {
+    unique_name = name + " #" + std::to_string(counter);
+  }
+
+  return unique_name;
+}
+
+GTFSReader::GTFSReader(std::string directory)
+    : directory_(std::move(directory)) {}
+
+bool GTFSReader::open(csv::CsvReader &reader,
+                      std::string_view file_name) const {
+  std::string path = directory_;
+
+  if (!path.empty() && path.back() != '/') {
+    path += '/';
+  }
+  path += file_name;
+
+  if (!reader.open(path)) {
+    std::cout << "gtfs: cannot open " << path << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool GTFSReader::parse(TransportCatalogue &catalogue) {
+  if (!parse_stops(catalogue) || !parse_routes() || !parse_trips() ||
+      !parse_stop_times(catalogue)) {
+    return false;
+  }
+
+  add_buses(catalogue);
+
+  catalogue.build_name_index();
+  catalogue.build_name_trie();
+  catalogue.build_spatial_index();
+  catalogue.refresh_network_stats();
+
+  return true;
+}
+
+bool GTFSReader::parse_stops(TransportCatalogue &catalogue) {
+  csv::CsvReader reader;
+
+  if (!open(reader, "stops.txt")) {
+    return false;
+  }
+
+  const int id_column = reader.get_column("stop_id");
+  const int name_column = reader.get_column("stop_name");
+  const int latitude_column = reader.get_column("stop_lat");
+  const int longitude_column = reader.get_column("stop_lon");
+  const int type_column = reader.get_column("location_type");
+
+  std::string name;
+
+  while (reader.read_row()) {
+    const std::string_view type = reader.get_field(type_column);
+
+    // Stations, entrances and other non-boarding locations are not stops.
+    if (!type.empty() && type != "0") {
+      continue;
+    }
+
+    const std::string_view stop_id = reader.get_field(id_column);
+    const double latitude = to_double(reader.get_field(latitude_column));
+    const double longitude = to_double(reader.get_field(longitude_column));
+
+    if (std::isnan(latitude) || std::isnan(longitude)) {
+      std::cout << "gtfs: stop " << stop_id
+                << " has no coordinates and is skipped" << std::endl;
+      continue;
+    }
+
+    // Names are the catalogue keys but are not unique in GTFS.
+    name = make_unique_name(std::string(reader.get_field(name_column)),
+                            stop_id, [&catalogue](const std::string &name) {
+                              return catalogue.get_stop(name) != nullptr;
+                            });
+
+    Stop stop;
+    stop.name = name;
+    stop.latitude = latitude;
+    stop.longitude = longitude;
+
+    catalogue.add_stop(std::move(stop));
+
+    stop_ids_.emplace(stop_id, static_cast<uint32_t>(stops_.size()));
+    stops_.push_back(catalogue.get_stop(name));
+  }
+
+  return true;
+}
+
+bool GTFSReader::parse_routes() {
+  csv::CsvReader reader;
+
+  if (!open(reader, "routes.txt")) {
+    return false;
+  }
+
+  const int id_column = reader.get_column("route_id");
+  const int short_name_column = reader.get_column("route_short_name");
+  const int long_name_column = reader.get_column("route_long_name");
+
+  while (reader.read_row()) {
+    const std::string_view route_id = reader.get_field(id_column);
+    std::string_view name = reader.get_field(short_name_column);
+
+    if (name.empty()) {
+      name = reader.get_field(long_name_column);
+    }
+    if (name.empty()) {
+      name = route_id;
+    }
+
+    routes_.emplace(route_id, static_cast<uint32_t>(route_names_.size()));
+    route_ids_.emplace_back(route_id);
+    route_names_.emplace_back(name);
+  }
+
+  return true;
+}
+
+bool GTFSReader::parse_trips() {
+  csv::CsvReader reader;
+
+  if (!open(reader, "trips.txt")) {
+    return false;
+  }
+
+  const int route_column = reader.get_column("route_id");
+  const int trip_column = reader.get_column("trip_id");
+
+  while (reader.read_row()) {
+    auto it = routes_.find(std::string(reader.get_field(route_column)));
+
+    if (it != routes_.end()) {
+      trip_routes_.emplace(reader.get_field(trip_column), it->second);
+    }
+  }
+
+  return true;
+}
+
+bool GTFSReader::parse_stop_times(TransportCatalogue &catalogue) {
+  csv::CsvReader reader;
+
+  if (!open(reader, "stop_times.txt")) {
+    return false;
+  }
+
+  const int trip_column = reader.get_column("trip_id");
+  const int stop_column = reader.get_column("stop_id");
+  const int sequence_column = reader.get_column("stop_sequence");
+  const int shape_column = reader.get_column("shape_dist_traveled");
+
+  // Rows of one trip are expected to be adjacent, as every producer writes
+  // them; a trip split across the file yields one pattern per part.
+  std::string trip_id;
+  std::string stop_id;
+  uint32_t route = 0;
+  bool is_known_trip = false;
+
+  while (reader.read_row()) {
+    const std::string_view row_trip_id = reader.get_field(trip_column);
+
+    if (row_trip_id != trip_id) {
+      if (is_known_trip) {
+        add_trip(route, catalogue);
+      }
+
+      trip_id = row_trip_id;
+      trip_.clear();
+
+      auto it = trip_routes_.find(trip_id);
+      is_known_trip = it != trip_routes_.end();
+      route = is_known_trip ? it->second : 0;
+    }
+
+    if (!is_known_trip) {
+      continue;
+    }
+
+    stop_id = reader.get_field(stop_column);
+    auto it = stop_ids_.find(stop_id);
+
+    if (it != stop_ids_.end()) {
+      const std::string_view shape = reader.get_field(shape_column);
+
+      trip_.push_back({to_int(reader.get_field(sequence_column)), it->second,
+                       shape.empty() ? std::nan("") : to_double(shape)});
+    }
+  }
+
+  if (is_known_trip) {
+    add_trip(route, catalogue);
+  }
+
+  return true;
+}
+
+void GTFSReader::add_trip(uint32_t route, TransportCatalogue &catalogue) {
+  if (trip_.size() < 2) {
+    return;
+  }
+
+  std::sort(trip_.begin(), trip_.end(),
+            [](const TripStop &lhs, const TripStop &rhs) {
+              return lhs.sequence < rhs.sequence;
+            });
+
+  trip_stops_.clear();
+  for (const TripStop &trip_stop : trip_) {
+    trip_stops_.push_back(trip_stop.stop);
+  }
+
+  if (!patterns_.emplace(route, trip_stops_).second) {
+    return;
+  }
+
+  std::vector<Distance> distances;
+
+  for (size_t i = 1; i < trip_.size(); ++i) {
+    Stop *start = stops_[trip_[i - 1].stop];
+    Stop *end = stops_[trip_[i].stop];
+
+    if (start == end) {
+      continue;
+    }
+
+    double distance = trip_[i].shape_distance - trip_[i - 1].shape_distance;
+
+    if (std::isnan(distance) || distance <= 0.) {
+      distance = geo::compute_distance({start->latitude, start->longitude},
+                                       {end->latitude, end->longitude});
+    }
+
+    distances.push_back({start, end, static_cast<int>(std::lround(distance))});
+  }
+
+  catalogue.add_distance(distances);
+}
+
+void GTFSReader::add_buses(TransportCatalogue &catalogue) {
+  uint32_t route = 0;
+  size_t route_patterns = 0;
+  std::string name;
+
+  for (const auto &[pattern_route, pattern_stops] : patterns_) {
+    if (pattern_route != route) {
+      route = pattern_route;
+      route_patterns = 0;
+    }
+
+    name = route_names_[route];
+    if (++route_patterns > 1) {
+      name += " #" + std::to_string(route_patterns);
+    }
+
+    // Short names repeat across agencies, and one may even look like a
+    // pattern name of another route.
+    name = make_unique_name(std::move(name), route_ids_[route],
+                            [&catalogue](const std::string &name) {
+                              return catalogue.get_bus(name) != nullptr;
+                            });
+
+    Bus bus;
+    bus.name = name;
+    bus.is_roundtrip = true;
+
+    for (uint32_t stop : pattern_stops) {
+      bus.stops.push_back(stops_[stop]);
+    }
+
+    catalogue.add_bus(std::move(bus));
+  }
+}
+
+} // end namespace gtfs
+} // end namespace detail
+} // end namespace transport_catalogue
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csv_reader.h"
+#include "transport_catalogue.h"
+
+namespace transport_catalogue {
+namespace detail {
+namespace gtfs {
+
+// Builds a catalogue straight from a GTFS feed directory. The files are read
+// row by row through memory mappings; only stops, routes, trip ids and the
+// distinct stop patterns are kept, so stop_times.txt may exceed RAM.
+//
+// Every distinct stop sequence of a route becomes a roundtrip bus (GTFS trips
+// are one-way, the opposite direction is a pattern of its own). Road
+// distances come from shape_dist_traveled, taken to be in meters, or from the
+// geographic distance when the feed has no shapes.
+class GTFSReader {
+public:
+  explicit GTFSReader(std::string directory);
+
+  bool parse(TransportCatalogue &catalogue);
+
+private:
+  struct TripStop {
+    int sequence;
+    uint32_t stop;
+    double shape_distance;
+  };
+
+  bool open(csv::CsvReader &reader, std::string_view file_name) const;
+
+  bool parse_stops(TransportCatalogue &catalogue);
+  bool parse_routes();
+  bool parse_trips();
+  bool parse_stop_times(TransportCatalogue &catalogue);
+
+  void add_trip(uint32_t route, TransportCatalogue &catalogue);
+  void add_buses(TransportCatalogue &catalogue);
+
+  std::string directory_;
+
+  std::vector<Stop *> stops_;
+  std::unordered_map<std::string, uint32_t> stop_ids_;
+  std::unordered_map<std::string, uint32_t> routes_;
+  std::vector<std::string> route_ids_;
+  std::vector<std::string> route_names_;
+  std::unordered_map<std::string, uint32_t> trip_routes_;
+
+  // Stop sequences of trips, deduplicated per route.
+  std::vector<TripStop> trip_;
+  std::vector<uint32_t> trip_stops_;
+  std::set<std::pair<uint32_t, std::vector<uint32_t>>> patterns_;
+};
+
+} // end namespace gtfs
+} // end namespace detail
+} // end namespace transport_catalogue
\ No newline at end of file
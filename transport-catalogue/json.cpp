@@ -242,6 +242,7 @@ Node::Node(Dict dict) : value_(std::move(dict)) {}
 Node::Node(int value) : value_(value) {}
 Node::Node(string value) : value_(std::move(value)) {}
 Node::Node(double value) : value_(value) {}
+Node::Node(RawJson value) : value_(std::move(value)) {}
 
 const Array &Node::as_array() const {
   using namespace std::literals;
@@ -390,6 +391,22 @@ void print_value(bool value, const PrintContext &context) {
   context.out << std::boolalpha << value;
 }
 
+// The text was printed at no indentation, so every line after the first is
+// shifted to the indentation of the value; empty lines stay empty, as the
+// printer leaves them.
+void print_value(const RawJson &value, const PrintContext &context) {
+  bool line_start = false;
+
+  for (const char ch : value.text) {
+    if (line_start && ch != '\n') {
+      context.print_indent();
+    }
+
+    context.out.put(ch);
+    line_start = ch == '\n';
+  }
+}
+
 [[maybe_unused]] void print_value(Array nodes, const PrintContext &context) {
   std::ostream &out = context.out;
   out << "[\n"sv;
@@ -20,8 +20,18 @@ public:
   using runtime_error::runtime_error;
 };
 
+// JSON text printed as it is, indented to its place in the document, so an
+// answer serialized ahead of time is spliced in without building its nodes.
+struct RawJson {
+  std::string text;
+};
+
+inline bool operator==(const RawJson &lhs, const RawJson &rhs) {
+  return lhs.text == rhs.text;
+}
+
 class Node final : private std::variant<std::nullptr_t, Array, Dict, bool, int,
-                                        double, std::string> {
+                                        double, std::string, RawJson> {
 public:
   using variant::variant;
   using Value = variant;
@@ -34,6 +44,7 @@ public:
   Node(std::string value);
   Node(std::nullptr_t);
   Node(double value);
+  Node(RawJson value);
 
   const Array &as_array() const;
   const Dict &as_dict() const;
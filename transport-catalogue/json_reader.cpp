@@ -7,13 +7,13 @@ namespace json {
 JSONReader::JSONReader(Document doc) : document_(std::move(doc)) {}
 JSONReader::JSONReader(std::istream &input) : document_(json::load(input)) {}
 
-Stop JSONReader::parse_node_stop(Node &node) {
+Stop JSONReader::parse_node_stop(Node &node, TransportCatalogue &catalogue) {
   Stop stop;
   Dict stop_node;
 
   if (node.is_dict()) {
     stop_node = node.as_dict();
-    stop.name = stop_node.at("name").as_string();
+    stop.name = catalogue.add_name(stop_node.at("name").as_string());
     stop.latitude = stop_node.at("latitude").as_double();
     stop.longitude = stop_node.at("longitude").as_double();
   }
@@ -59,7 +59,7 @@ Bus JSONReader::parse_node_bus(Node &node, TransportCatalogue &catalogue) {
 
   if (node.is_dict()) {
     bus_node = node.as_dict();
-    bus.name = bus_node.at("name").as_string();
+    bus.name = catalogue.add_name(bus_node.at("name").as_string());
     bus.is_roundtrip = bus_node.at("is_roundtrip").as_bool();
 
     try {
@@ -69,14 +69,6 @@ Bus JSONReader::parse_node_bus(Node &node, TransportCatalogue &catalogue) {
         bus.stops.push_back(catalogue.get_stop(stop.as_string()));
       }
 
-      if (!bus.is_roundtrip) {
-        size_t size = bus.stops.size() - 1;
-
-        for (size_t i = size; i > 0; i--) {
-          bus.stops.push_back(bus.stops[i - 1]);
-        }
-      }
-
     } catch (...) {
       std::cout << "base_requests: bus: stops is empty" << std::endl;
     }
@@ -122,7 +114,7 @@ void JSONReader::parse_node_base(const Node &root,
     }
 
     for (auto stop : stops) {
-      catalogue.add_stop(parse_node_stop(stop));
+      catalogue.add_stop(parse_node_stop(stop, catalogue));
     }
 
     for (auto stop : stops) {
@@ -133,11 +125,179 @@ void JSONReader::parse_node_base(const Node &root,
       catalogue.add_bus(parse_node_bus(bus, catalogue));
     }
 
+    catalogue.build_name_index();
+    catalogue.build_name_trie();
+    catalogue.build_spatial_index();
+    catalogue.refresh_network_stats();
+
   } else {
     std::cout << "base_requests is not an array";
   }
 }
 
+void JSONReader::parse_node_delta(const Node &root,
+                                  TransportCatalogue &catalogue) {
+  std::vector<Node> stops;
+  std::vector<Node> removed_stops;
+  std::vector<Node> distances;
+  std::vector<Node> buses;
+
+  if (!root.is_array()) {
+    std::cout << "delta_requests is not an array";
+    return;
+  }
+
+  for (const Node &node : root.as_array()) {
+    if (!node.is_dict()) {
+      continue;
+    }
+
+    try {
+      const std::string &type = node.as_dict().at("type").as_string();
+      const std::string &action = node.as_dict().at("action").as_string();
+
+      if (type == "Stop") {
+        (action == "remove" ? removed_stops : stops).push_back(node);
+      } else if (type == "Distance") {
+        distances.push_back(node);
+      } else if (type == "Bus") {
+        buses.push_back(node);
+      } else {
+        std::cout << "delta_requests are invalid";
+      }
+
+    } catch (...) {
+      std::cout << "delta_requests does not have type or action value";
+    }
+  }
+
+  // Road distances are applied only for the stops added or moved here, not
+  // for rejected ones.
+  std::vector<Node> applied_stops;
+
+  for (auto stop : stops) {
+    try {
+      const Dict &stop_map = stop.as_dict();
+      const std::string &name = stop_map.at("name").as_string();
+
+      if (stop_map.at("action").as_string() == "add") {
+
+        if (catalogue.get_stop(name)) {
+          std::cout << "delta_requests: stop already exists: " << name;
+        } else {
+          catalogue.add_stop(parse_node_stop(stop, catalogue));
+          applied_stops.push_back(stop);
+        }
+
+      } else if (!catalogue.update_stop(
+                     name, {stop_map.at("latitude").as_double(),
+                            stop_map.at("longitude").as_double()})) {
+        std::cout << "delta_requests: stop not found: " << name;
+      } else {
+        applied_stops.push_back(stop);
+      }
+
+    } catch (...) {
+      std::cout << "delta_requests: stop is invalid";
+    }
+  }
+
+  for (auto stop : applied_stops) {
+    if (!stop.as_dict().count("road_distances")) {
+      continue;
+    }
+
+    // The other end may be missing: a stop the delta names but never adds,
+    // or one whose add was rejected above.
+    std::vector<Distance> distances = parse_node_distances(stop, catalogue);
+    const auto missing =
+        std::remove_if(distances.begin(), distances.end(),
+                       [](const Distance &distance) {
+                         return !distance.start || !distance.end;
+                       });
+
+    if (missing != distances.end()) {
+      std::cout << "delta_requests: distance stop not found";
+      distances.erase(missing, distances.end());
+    }
+
+    catalogue.add_distance(distances);
+  }
+
+  for (auto distance : distances) {
+    try {
+      const Dict &distance_map = distance.as_dict();
+      Stop *start = catalogue.get_stop(distance_map.at("from").as_string());
+      Stop *end = catalogue.get_stop(distance_map.at("to").as_string());
+
+      if (!start || !end) {
+        std::cout << "delta_requests: distance stop not found";
+      } else if (distance_map.at("action").as_string() == "remove") {
+        catalogue.remove_distance(start, end);
+      } else {
+        catalogue.add_distance(
+            {{start, end, distance_map.at("distance").as_int()}});
+      }
+
+    } catch (...) {
+      std::cout << "delta_requests: distance is invalid";
+    }
+  }
+
+  for (auto bus : buses) {
+    try {
+      const Dict &bus_map = bus.as_dict();
+      const std::string &name = bus_map.at("name").as_string();
+      const std::string &action = bus_map.at("action").as_string();
+
+      if (action == "remove") {
+        if (!catalogue.remove_bus(name)) {
+          std::cout << "delta_requests: bus not found: " << name;
+        }
+        continue;
+      }
+
+      if (action == "add" && catalogue.get_bus(name)) {
+        std::cout << "delta_requests: bus already exists: " << name;
+        continue;
+      }
+
+      Bus tc_bus = parse_node_bus(bus, catalogue);
+
+      if (std::count(tc_bus.stops.begin(), tc_bus.stops.end(), nullptr)) {
+        std::cout << "delta_requests: bus stop not found: " << name;
+      } else if (action == "add") {
+        catalogue.add_bus(std::move(tc_bus));
+      } else if (!catalogue.update_bus(std::move(tc_bus))) {
+        std::cout << "delta_requests: bus not found: " << name;
+      }
+
+    } catch (...) {
+      std::cout << "delta_requests: bus is invalid";
+    }
+  }
+
+  for (auto stop : removed_stops) {
+    try {
+      const std::string &name = stop.as_dict().at("name").as_string();
+
+      if (!catalogue.remove_stop(name)) {
+        std::cout << "delta_requests: unable to remove stop: " << name;
+      }
+
+    } catch (...) {
+      std::cout << "delta_requests: stop is invalid";
+    }
+  }
+
+  // Only the route lengths and bus lists are updated per change; the
+  // indexes and the statistics are built again over the whole network.
+  catalogue.build_name_index();
+  catalogue.build_name_trie();
+  catalogue.build_spatial_index();
+  catalogue.refresh_network_stats();
+}
+
 void JSONReader::parse_node_stat(const Node &node,
                                  std::vector<StatRequest> &stat_request) {
   Array stat_requests;
@@ -154,14 +314,15 @@ void JSONReader::parse_node_stat(const Node &node,
         req.id = req_map.at("id").as_int();
         req.type = req_map.at("type").as_string();
 
-        if ((req.type == "Bus") || (req.type == "Stop")) {
+        if ((req.type == "Bus") || (req.type == "Stop") ||
+            (req.type == "SegmentLength")) {
           req.name = req_map.at("name").as_string();
           req.from = "";
           req.to = "";
 
         } else {
           req.name = "";
-          if (req.type == "Route") {
+          if ((req.type == "Route") || (req.type == "DirectBuses")) {
             req.from = req_map.at("from").as_string();
             req.to = req_map.at("to").as_string();
 
@@ -171,6 +332,29 @@ void JSONReader::parse_node_stat(const Node &node,
           }
         }
 
+        if (req.type == "NearestStops") {
+          req.coordinates = {req_map.at("latitude").as_double(),
+                             req_map.at("longitude").as_double()};
+          req.count = req_map.at("count").as_int();
+
+        } else if (req.type == "StopsInArea") {
+          req.area = {req_map.at("min_latitude").as_double(),
+                      req_map.at("min_longitude").as_double(),
+                      req_map.at("max_latitude").as_double(),
+                      req_map.at("max_longitude").as_double()};
+
+        } else if (req.type == "StopSearch") {
+          req.name = req_map.at("query").as_string();
+          req.limit = req_map.at("limit").as_int();
+          req.max_edits = req_map.count("max_edits")
+                              ? req_map.at("max_edits").as_int()
+                              : 0;
+
+        } else if (req.type == "SegmentLength") {
+          req.from_index = req_map.at("from_index").as_int();
+          req.to_index = req_map.at("to_index").as_int();
+        }
+
         stat_request.push_back(req);
       }
     }
@@ -307,6 +491,26 @@ void JSONReader::parse_node_serialization(
     try {
       serialization_set.file_name = serialization.at("file").as_string();
 
+      const std::string format = serialization.count("format")
+                                     ? serialization.at("format").as_string()
+                                     : "";
+
+      if (format == "compact") {
+        serialization_set.format = serialization::Format::COMPACT;
+      } else if (format == "flat") {
+        serialization_set.format = serialization::Format::FLAT;
+      }
+
+      if (serialization.count("route_table")) {
+        serialization_set.route_table_file =
+            serialization.at("route_table").as_string();
+      }
+
+      if (serialization.count("precompute_answers")) {
+        serialization_set.precompute_answers =
+            serialization.at("precompute_answers").as_bool();
+      }
+
     } catch (...) {
       std::cout << "unable to parse serialization settings";
     }
@@ -383,6 +587,71 @@ void JSONReader::parse_node_process_requests(
   }
 }
 
+void JSONReader::parse_node_apply_delta(
+    serialization::SerializationSettings &serialization_settings) {
+  Dict root_dictionary;
+
+  if (document_.get_root().is_dict()) {
+    root_dictionary = document_.get_root().as_dict();
+
+    try {
+      parse_node_serialization(root_dictionary.at("serialization_settings"),
+                               serialization_settings);
+
+    } catch (...) {
+    }
+
+  } else {
+    std::cout << "root is not map";
+  }
+}
+
+void JSONReader::apply_delta(TransportCatalogue &catalogue) {
+
+  if (document_.get_root().is_dict()) {
+
+    try {
+      parse_node_delta(document_.get_root().as_dict().at("delta_requests"),
+                       catalogue);
+
+    } catch (...) {
+    }
+
+  } else {
+    std::cout << "root is not map";
+  }
+}
+
+void JSONReader::parse_node_export(
+    serialization::SerializationSettings &serialization_settings,
+    columnar_export::ExportSettings &export_settings) {
+  Dict root_dictionary;
+
+  if (document_.get_root().is_dict()) {
+    root_dictionary = document_.get_root().as_dict();
+
+    try {
+      parse_node_serialization(root_dictionary.at("serialization_settings"),
+                               serialization_settings);
+
+    } catch (...) {
+    }
+
+    try {
+      export_settings.directory = root_dictionary.at("export_settings")
+                                      .as_dict()
+                                      .at("directory")
+                                      .as_string();
+
+    } catch (...) {
+      std::cout << "unable to parse export settings";
+    }
+
+  } else {
+    std::cout << "root is not map";
+  }
+}
+
 } // end namespace json
 } // end namespace detail
 } // end namespace transport_catalogue
\ No newline at end of file
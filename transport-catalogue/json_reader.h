@@ -1,4 +1,5 @@
 #pragma once
+#include "columnar_export.h"
 #include "json.h"
 #include "map_renderer.h"
 #include "serialization.h"
@@ -16,6 +17,7 @@ public:
   JSONReader(std::istream &input);
 
   void parse_node_base(const Node &root, TransportCatalogue &catalogue);
+  void parse_node_delta(const Node &root, TransportCatalogue &catalogue);
   void parse_node_stat(const Node &root,
                        std::vector<StatRequest> &stat_request);
   void parse_node_render(const Node &node,
@@ -35,7 +37,15 @@ public:
       std::vector<StatRequest> &stat_request,
       serialization::SerializationSettings &serialization_settings);
 
-  Stop parse_node_stop(Node &node);
+  void parse_node_apply_delta(
+      serialization::SerializationSettings &serialization_settings);
+  void apply_delta(TransportCatalogue &catalogue);
+
+  void parse_node_export(
+      serialization::SerializationSettings &serialization_settings,
+      columnar_export::ExportSettings &export_settings);
+
+  Stop parse_node_stop(Node &node, TransportCatalogue &catalogue);
   Bus parse_node_bus(Node &node, TransportCatalogue &catalogue);
   std::vector<Distance> parse_node_distances(Node &node,
                                              TransportCatalogue &catalogue);
@@ -1,12 +1,15 @@
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 
+#include "gtfs_reader.h"
 #include "json_reader.h"
 #include "request_handler.h"
 
 using namespace std;
 
 using namespace transport_catalogue;
+using namespace transport_catalogue::detail::gtfs;
 using namespace transport_catalogue::detail::json;
 using namespace transport_catalogue::detail::router;
 
@@ -15,18 +18,39 @@ using namespace request_handler;
 using namespace serialization;
 
 void PrintUsage(std::ostream &stream = std::cerr) {
-  stream << "Usage: transport_catalogue [make_base|process_requests]\n"sv;
+  stream << "Usage: transport_catalogue "
+            "[make_base [--gtfs <dir>]|process_requests|apply_delta|"
+            "export]\n"sv;
+}
+
+// Computes the routes between all stops and writes them for process_requests
+// to map instead of computing them again.
+void WriteRouteTable(const FrozenCatalogue &catalogue,
+                     const RoutingSettings &routing_settings,
+                     const string &file_name) {
+  TransportRouter transport_router;
+
+  transport_router.set_routing_settings(routing_settings);
+  transport_router.build_router(catalogue);
+
+  ofstream out_file(file_name, ios::binary);
+  transport_router.save_route_table(out_file);
 }
 
 int main(int argc, char *argv[]) {
 
-  if (argc != 2) {
+  if (argc != 2 && !(argc == 4 && argv[2] == "--gtfs"sv)) {
     PrintUsage();
     return 1;
   }
 
   const std::string_view mode(argv[1]);
 
+  if (argc == 4 && mode != "make_base"sv) {
+    PrintUsage();
+    return 1;
+  }
+
   TransportCatalogue transport_catalogue;
 
   RenderSettings render_settings;
@@ -44,9 +68,44 @@ int main(int argc, char *argv[]) {
     json_reader.parse_node_make_base(transport_catalogue, render_settings,
                                      routing_settings, serialization_settings);
 
+    // With --gtfs the JSON input carries only the settings, the network is
+    // read from the feed.
+    if (argc == 4 && !GTFSReader(argv[3]).parse(transport_catalogue)) {
+      return 1;
+    }
+
+    // The map depends on nothing but the base, so it is rendered once here
+    // and Map requests are answered with the stored copy; so are the Stop
+    // and Bus answers if asked for.
+    const FrozenCatalogue frozen_catalogue = transport_catalogue.freeze();
+    RequestHandler request_handler;
+    Precomputed precomputed;
+
+    precomputed.map =
+        request_handler.render_map(frozen_catalogue, render_settings);
+
+    if (serialization_settings.precompute_answers) {
+      precomputed.stop_answers =
+          request_handler.precompute_stop_answers(frozen_catalogue);
+      precomputed.bus_answers =
+          request_handler.precompute_bus_answers(frozen_catalogue);
+    }
+
     ofstream out_file(serialization_settings.file_name, ios::binary);
-    catalogue_serialization(transport_catalogue, render_settings,
-                            routing_settings, out_file);
+
+    if (serialization_settings.format == Format::FLAT) {
+      flat_catalogue_serialization(frozen_catalogue, render_settings,
+                                   routing_settings, precomputed, out_file);
+    } else {
+      catalogue_serialization(
+          transport_catalogue, render_settings, routing_settings, precomputed,
+          serialization_settings.format == Format::COMPACT, out_file);
+    }
+
+    if (!serialization_settings.route_table_file.empty()) {
+      WriteRouteTable(frozen_catalogue, routing_settings,
+                      serialization_settings.route_table_file);
+    }
 
   } else if (mode == "process_requests"sv) {
 
@@ -55,18 +114,119 @@ int main(int argc, char *argv[]) {
     json_reader.parse_node_process_requests(stat_request,
                                             serialization_settings);
 
-    ifstream in_file(serialization_settings.file_name, ios::binary);
+    const RequestMix mix = inspect_requests(stat_request);
 
-    Catalogue catalogue = catalogue_deserialization(in_file);
+    BaseSections sections;
+
+    sections.render_settings = mix.has_map;
+    sections.routing_settings = mix.has_route;
+    sections.map = mix.has_map;
+    sections.answers = mix.has_stop || mix.has_bus;
+
+    FlatReader flat_base;
+    FrozenBase base = load_frozen_base(serialization_settings.file_name,
+                                       flat_base, sections);
 
     RequestHandler request_handler;
 
-    request_handler.execute_queries(catalogue.transport_catalogue_,
-                                    stat_request, catalogue.render_settings_,
-                                    catalogue.routing_settings_);
+    request_handler.set_prerendered_map(std::move(base.precomputed_.map));
+    request_handler.set_precomputed_answers(
+        std::move(base.precomputed_.stop_answers),
+        std::move(base.precomputed_.bus_answers));
+
+    graph::RouteTable route_table;
+
+    if (mix.has_route && !serialization_settings.route_table_file.empty() &&
+        route_table.open(serialization_settings.route_table_file)) {
+      request_handler.set_route_table(&route_table);
+    }
+
+    request_handler.execute_queries(base.catalogue_, stat_request,
+                                    base.render_settings_,
+                                    base.routing_settings_);
 
     print(request_handler.get_document(), cout);
 
+  } else if (mode == "apply_delta"sv) {
+
+    json_reader = JSONReader(cin);
+
+    json_reader.parse_node_apply_delta(serialization_settings);
+
+    if (FlatReader().open(serialization_settings.file_name)) {
+      cerr << "apply_delta: a flat base is read-only, rebuild it with "
+              "make_base"sv
+           << endl;
+      return 1;
+    }
+
+    ifstream in_file(serialization_settings.file_name, ios::binary);
+    Catalogue catalogue = catalogue_deserialization(in_file);
+    in_file.close();
+
+    json_reader.apply_delta(catalogue.transport_catalogue_);
+
+    // Everything precomputed depends on the network, so it is computed
+    // again; the answers only if the base had them. This, the route table
+    // and reading and writing the base take as long as make_base on the
+    // same network, however small the delta: it spares sending the whole
+    // network again, not rebuilding what is derived from it.
+    const FrozenCatalogue frozen_catalogue =
+        catalogue.transport_catalogue_.freeze();
+    Precomputed &precomputed = catalogue.precomputed_;
+    RequestHandler request_handler;
+
+    precomputed.map = request_handler.render_map(frozen_catalogue,
+                                                 catalogue.render_settings_);
+
+    if (!precomputed.stop_answers.empty() || !precomputed.bus_answers.empty()) {
+      precomputed.stop_answers =
+          request_handler.precompute_stop_answers(frozen_catalogue);
+      precomputed.bus_answers =
+          request_handler.precompute_bus_answers(frozen_catalogue);
+    }
+
+    // The base is written beside the old one and renamed over it, so a
+    // failed write leaves the old base intact.
+    const string temp_file_name = serialization_settings.file_name + ".tmp";
+    ofstream out_file(temp_file_name, ios::binary);
+
+    catalogue_serialization(catalogue.transport_catalogue_,
+                            catalogue.render_settings_,
+                            catalogue.routing_settings_, precomputed,
+                            catalogue.compact_, out_file);
+    out_file.close();
+
+    if (!out_file || rename(temp_file_name.c_str(),
+                            serialization_settings.file_name.c_str()) != 0) {
+      cerr << "apply_delta: cannot write the base"sv << endl;
+      remove(temp_file_name.c_str());
+      return 1;
+    }
+
+    // A table left from before the delta would no longer match the base and
+    // be ignored.
+    if (!serialization_settings.route_table_file.empty()) {
+      WriteRouteTable(frozen_catalogue, catalogue.routing_settings_,
+                      serialization_settings.route_table_file);
+    }
+
+  } else if (mode == "export"sv) {
+
+    columnar_export::ExportSettings export_settings;
+
+    json_reader = JSONReader(cin);
+
+    json_reader.parse_node_export(serialization_settings, export_settings);
+
+    FlatReader flat_base;
+    FrozenBase base = load_frozen_base(serialization_settings.file_name,
+                                       flat_base, {false, false, false, false});
+
+    if (!columnar_export::export_catalogue(base.catalogue_, export_settings)) {
+      return 1;
+    }
+
   } else {
     PrintUsage();
     return 1;
@@ -126,17 +126,16 @@ void MapRenderer::set_stops_text_color_properties(svg::Text &text,
   text.set_fill_color("black");
 }
 
-void MapRenderer::add_line(std::vector<std::pair<Bus *, int>> &buses_palette) {
+void MapRenderer::add_line(
+    const transport_catalogue::FrozenCatalogue &catalogue,
+    std::vector<std::pair<const transport_catalogue::FrozenBus *, int>>
+        &buses_palette) {
   std::vector<geo::Coordinates> stops_geo_coords;
 
   for (auto [bus, palette] : buses_palette) {
 
-    for (Stop *stop : bus->stops) {
-      geo::Coordinates coordinates;
-      coordinates.latitude = stop->latitude;
-      coordinates.longitude = stop->longitude;
-
-      stops_geo_coords.push_back(coordinates);
+    for (uint32_t stop_id : catalogue.get_bus_stops(*bus)) {
+      stops_geo_coords.push_back(catalogue.get_stops()[stop_id].coordinates);
     }
 
     svg::Polyline bus_line;
@@ -157,18 +156,17 @@ void MapRenderer::add_line(std::vector<std::pair<Bus *, int>> &buses_palette) {
 }
 
 void MapRenderer::add_buses_name(
-    std::vector<std::pair<Bus *, int>> &buses_palette) {
+    const transport_catalogue::FrozenCatalogue &catalogue,
+    std::vector<std::pair<const transport_catalogue::FrozenBus *, int>>
+        &buses_palette) {
   std::vector<geo::Coordinates> stops_geo_coords;
   bool bus_empty = true;
 
   for (auto [bus, palette] : buses_palette) {
+    const std::string bus_name(catalogue.get_name(bus->name));
 
-    for (Stop *stop : bus->stops) {
-      geo::Coordinates coordinates;
-      coordinates.latitude = stop->latitude;
-      coordinates.longitude = stop->longitude;
-
-      stops_geo_coords.push_back(coordinates);
+    for (uint32_t stop_id : catalogue.get_bus_stops(*bus)) {
+      stops_geo_coords.push_back(catalogue.get_stops()[stop_id].coordinates);
 
       if (bus_empty)
         bus_empty = false;
@@ -183,35 +181,35 @@ void MapRenderer::add_buses_name(
 
       if (bus->is_roundtrip) {
         set_route_text_additional_properties(
-            route_name_roundtrip, std::string(bus->name),
+            route_name_roundtrip, bus_name,
             sphere_projector(stops_geo_coords[0]));
         map_svg.add(route_name_roundtrip);
 
         set_route_text_color_properties(route_title_roundtrip,
-                                        std::string(bus->name), palette,
+                                        bus_name, palette,
                                         sphere_projector(stops_geo_coords[0]));
         map_svg.add(route_title_roundtrip);
 
       } else {
         set_route_text_additional_properties(
-            route_name_roundtrip, std::string(bus->name),
+            route_name_roundtrip, bus_name,
             sphere_projector(stops_geo_coords[0]));
         map_svg.add(route_name_roundtrip);
 
         set_route_text_color_properties(route_title_roundtrip,
-                                        std::string(bus->name), palette,
+                                        bus_name, palette,
                                         sphere_projector(stops_geo_coords[0]));
         map_svg.add(route_title_roundtrip);
 
         if (stops_geo_coords[0] !=
             stops_geo_coords[stops_geo_coords.size() / 2]) {
           set_route_text_additional_properties(
-              route_name_notroundtrip, std::string(bus->name),
+              route_name_notroundtrip, bus_name,
               sphere_projector(stops_geo_coords[stops_geo_coords.size() / 2]));
           map_svg.add(route_name_notroundtrip);
 
           set_route_text_color_properties(
-              route_title_notroundtrip, std::string(bus->name), palette,
+              route_title_notroundtrip, bus_name, palette,
               sphere_projector(stops_geo_coords[stops_geo_coords.size() / 2]));
           map_svg.add(route_title_notroundtrip);
         }
@@ -223,42 +221,39 @@ void MapRenderer::add_buses_name(
   }
 }
 
-void MapRenderer::add_stops_circle(std::vector<Stop *> &stops) {
-  std::vector<geo::Coordinates> stops_geo_coords;
+void MapRenderer::add_stops_circle(
+    std::vector<const transport_catalogue::FrozenStop *> &stops) {
   svg::Circle icon;
 
-  for (Stop *stop_info : stops) {
+  for (const auto *stop_info : stops) {
 
     if (stop_info) {
-      geo::Coordinates coordinates;
-      coordinates.latitude = stop_info->latitude;
-      coordinates.longitude = stop_info->longitude;
-
-      set_stops_circles_properties(icon, sphere_projector(coordinates));
+      set_stops_circles_properties(icon,
+                                   sphere_projector(stop_info->coordinates));
       map_svg.add(icon);
     }
   }
 }
 
-void MapRenderer::add_stops_name(std::vector<Stop *> &stops) {
-  std::vector<geo::Coordinates> stops_geo_coords;
-
+void MapRenderer::add_stops_name(
+    const transport_catalogue::FrozenCatalogue &catalogue,
+    std::vector<const transport_catalogue::FrozenStop *> &stops) {
   svg::Text svg_stop_name;
   svg::Text svg_stop_name_title;
 
-  for (Stop *stop_info : stops) {
+  for (const auto *stop_info : stops) {
 
     if (stop_info) {
-      geo::Coordinates coordinates;
-      coordinates.latitude = stop_info->latitude;
-      coordinates.longitude = stop_info->longitude;
+      const std::string stop_name(catalogue.get_name(stop_info->name));
 
-      set_stops_text_additional_properties(svg_stop_name, stop_info->name,
-                                           sphere_projector(coordinates));
+      set_stops_text_additional_properties(
+          svg_stop_name, stop_name,
+          sphere_projector(stop_info->coordinates));
       map_svg.add(svg_stop_name);
 
-      set_stops_text_color_properties(svg_stop_name_title, stop_info->name,
-                                      sphere_projector(coordinates));
+      set_stops_text_color_properties(
+          svg_stop_name_title, stop_name,
+          sphere_projector(stop_info->coordinates));
       map_svg.add(svg_stop_name_title);
     }
   }
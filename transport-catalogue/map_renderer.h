@@ -5,6 +5,7 @@
 #include <optional>
 
 #include "domain.h"
+#include "frozen_catalogue.h"
 #include "geo.h"
 #include "svg.h"
 
@@ -84,10 +85,18 @@ public:
   void set_stops_text_color_properties(svg::Text &text, const std::string &name,
                                        svg::Point position) const;
 
-  void add_line(std::vector<std::pair<Bus *, int>> &buses_palette);
-  void add_buses_name(std::vector<std::pair<Bus *, int>> &buses_palette);
-  void add_stops_circle(std::vector<Stop *> &stops_name);
-  void add_stops_name(std::vector<Stop *> &stops_name);
+  void add_line(const transport_catalogue::FrozenCatalogue &catalogue,
+                std::vector<std::pair<const transport_catalogue::FrozenBus *,
+                                      int>> &buses_palette);
+  void add_buses_name(
+      const transport_catalogue::FrozenCatalogue &catalogue,
+      std::vector<std::pair<const transport_catalogue::FrozenBus *, int>>
+          &buses_palette);
+  void add_stops_circle(
+      std::vector<const transport_catalogue::FrozenStop *> &stops_name);
+  void add_stops_name(
+      const transport_catalogue::FrozenCatalogue &catalogue,
+      std::vector<const transport_catalogue::FrozenStop *> &stops_name);
 
   void get_stream_map(std::ostream &stream_);
 
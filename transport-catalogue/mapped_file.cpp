@@ -0,0 +1,76 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace domain {
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string &path) {
+  close();
+
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    close();
+    return false;
+  }
+
+  size_ = static_cast<size_t>(file_stat.st_size);
+  if (size_ == 0) {
+    return true;
+  }
+
+  data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  size_ = 0;
+}
+
+std::string_view MappedFile::get_data() const {
+  return {static_cast<const char *>(data_), data_ ? size_ : 0};
+}
+
+void MappedFile::advise_sequential() const {
+  if (data_) {
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+}
+
+void MappedFile::release(size_t size) {
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size = std::min(size, size_) / page_size * page_size;
+
+  if (data_ && size > 0) {
+    madvise(data_, size, MADV_DONTNEED);
+  }
+}
+
+} // end namespace domain
\ No newline at end of file
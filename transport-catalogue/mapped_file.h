@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace domain {
+
+// Read-only memory mapping of a whole file. Pages are loaded by the kernel on
+// first access, so a file larger than RAM can be read through it as long as
+// consumed parts are released.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+
+  std::string_view get_data() const;
+
+  // Hints the kernel to read ahead aggressively, for front to back scans.
+  void advise_sequential() const;
+
+  // Drops the pages of the first size bytes from memory; they are read from
+  // the file again if accessed later.
+  void release(size_t size);
+
+private:
+  int fd_ = -1;
+  void *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "memory_arena.h"
+
+namespace domain {
+
+MemoryArena::MemoryArena(size_t initial_size) : upstream_(initial_size) {}
+
+void *MemoryArena::do_allocate(size_t bytes, size_t alignment) {
+  return upstream_.allocate(bytes, alignment);
+}
+
+void MemoryArena::do_deallocate([[maybe_unused]] void *ptr,
+                                [[maybe_unused]] size_t bytes,
+                                [[maybe_unused]] size_t alignment) {}
+
+bool MemoryArena::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+} // end namespace domain
\ No newline at end of file
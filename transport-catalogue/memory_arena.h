@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace domain {
+
+// Monotonic memory resource that backs a catalogue for its whole lifetime.
+// Deallocation is a no-op, everything is released at once on destruction.
+class MemoryArena : public std::pmr::memory_resource {
+public:
+  MemoryArena() = default;
+  explicit MemoryArena(size_t initial_size);
+
+  MemoryArena(const MemoryArena &) = delete;
+  MemoryArena &operator=(const MemoryArena &) = delete;
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override;
+
+  std::pmr::monotonic_buffer_resource upstream_;
+};
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "name_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace domain {
+
+NameArena::NameArena(std::pmr::memory_resource *resource)
+    : resource_(resource) {}
+
+NameArena::~NameArena() { release(); }
+
+NameArena::NameArena(NameArena &&other) noexcept
+    : resource_(other.resource_), blocks_(std::move(other.blocks_)),
+      size_(other.size_) {
+  other.blocks_.clear();
+  other.size_ = 0;
+}
+
+NameArena &NameArena::operator=(NameArena &&other) noexcept {
+  if (this != &other) {
+    release();
+
+    resource_ = other.resource_;
+    blocks_ = std::move(other.blocks_);
+    size_ = other.size_;
+
+    other.blocks_.clear();
+    other.size_ = 0;
+  }
+
+  return *this;
+}
+
+void NameArena::release() {
+  for (Block &block : blocks_) {
+    resource_->deallocate(block.data, block.capacity, alignof(char));
+  }
+
+  blocks_.clear();
+  size_ = 0;
+}
+
+NameArena::Block &NameArena::add_block(size_t capacity) {
+  Block block;
+  block.data =
+      static_cast<char *>(resource_->allocate(capacity, alignof(char)));
+  block.capacity = capacity;
+  block.base = size_;
+
+  blocks_.push_back(std::move(block));
+  return blocks_.back();
+}
+
+std::string_view NameArena::add(std::string_view name) {
+  if (contains(name)) {
+    return name;
+  }
+
+  if (blocks_.empty() ||
+      blocks_.back().capacity - blocks_.back().used < name.size()) {
+    size_t capacity = blocks_.empty() ? MIN_BLOCK_SIZE
+                                      : 2 * blocks_.back().capacity;
+    add_block(std::max(capacity, name.size()));
+  }
+
+  Block &block = blocks_.back();
+  char *dest = block.data + block.used;
+
+  if (!name.empty()) {
+    std::memcpy(dest, name.data(), name.size());
+  }
+
+  block.used += name.size();
+  size_ += name.size();
+
+  return {dest, name.size()};
+}
+
+void NameArena::assign(std::string_view blob) {
+  release();
+
+  Block &block = add_block(std::max(blob.size(), size_t{1}));
+
+  if (!blob.empty()) {
+    std::memcpy(block.data, blob.data(), blob.size());
+  }
+
+  block.used = blob.size();
+  size_ = blob.size();
+}
+
+const NameArena::Block *NameArena::find_block(const char *ptr) const {
+  for (const Block &block : blocks_) {
+    const char *begin = block.data;
+
+    if (std::less_equal<const char *>{}(begin, ptr) &&
+        std::less<const char *>{}(ptr, begin + block.capacity)) {
+      return &block;
+    }
+  }
+
+  return nullptr;
+}
+
+bool NameArena::contains(std::string_view name) const {
+  return !name.empty() && find_block(name.data()) != nullptr;
+}
+
+uint32_t NameArena::get_offset(std::string_view name) const {
+  if (name.empty()) {
+    return 0;
+  }
+
+  const Block *block = find_block(name.data());
+
+  if (!block) {
+    throw std::invalid_argument("name is not stored in the arena");
+  }
+
+  return static_cast<uint32_t>(block->base + (name.data() - block->data));
+}
+
+std::string_view NameArena::get_name(uint32_t offset, uint32_t size) const {
+  if (size == 0) {
+    return {};
+  }
+
+  auto it = std::upper_bound(
+      blocks_.begin(), blocks_.end(), size_t{offset},
+      [](size_t value, const Block &block) { return value < block.base; });
+
+  if (it == blocks_.begin() || offset + size > size_) {
+    throw std::out_of_range("name is out of the arena bounds");
+  }
+
+  const Block &block = *std::prev(it);
+  return {block.data + (offset - block.base), size};
+}
+
+std::string NameArena::get_blob() const {
+  std::string blob;
+  blob.reserve(size_);
+
+  for (const Block &block : blocks_) {
+    blob.append(block.data, block.used);
+  }
+
+  return blob;
+}
+
+size_t NameArena::get_size() const { return size_; }
+
+} // end namespace domain
\ No newline at end of file
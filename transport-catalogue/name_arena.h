@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace domain {
+
+// Append-only storage for stop and bus names. Every name lives in one of a
+// few large blocks, so the returned string_view handles stay valid for the
+// whole lifetime of the arena (moves included). A loaded base keeps all the
+// names in a single contiguous block.
+class NameArena {
+public:
+  NameArena() = default;
+  explicit NameArena(std::pmr::memory_resource *resource);
+  ~NameArena();
+
+  NameArena(const NameArena &) = delete;
+  NameArena &operator=(const NameArena &) = delete;
+  NameArena(NameArena &&other) noexcept;
+  NameArena &operator=(NameArena &&other) noexcept;
+
+  std::string_view add(std::string_view name);
+  void assign(std::string_view blob);
+
+  bool contains(std::string_view name) const;
+  uint32_t get_offset(std::string_view name) const;
+  std::string_view get_name(uint32_t offset, uint32_t size) const;
+
+  std::string get_blob() const;
+  size_t get_size() const;
+
+private:
+  struct Block {
+    char *data = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t base = 0;
+  };
+
+  static const size_t MIN_BLOCK_SIZE = 4096;
+
+  const Block *find_block(const char *ptr) const;
+  Block &add_block(size_t capacity);
+  void release();
+
+  std::pmr::memory_resource *resource_ = std::pmr::get_default_resource();
+  std::vector<Block> blocks_;
+  size_t size_ = 0;
+};
+
+} // end namespace domain
\ No newline at end of file
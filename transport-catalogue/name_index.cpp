@@ -0,0 +1,178 @@
+#include "name_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace domain {
+
+static const uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+NameIndex::NameIndex(uint64_t seed, FlatArray<uint32_t> displacements,
+                     FlatArray<uint32_t> slots)
+    : seed_(seed), displacements_(std::move(displacements)),
+      slots_(std::move(slots)) {}
+
+uint64_t NameIndex::mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+
+  return value;
+}
+
+uint64_t NameIndex::hash(std::string_view name, uint64_t seed) {
+  uint64_t value = 0xcbf29ce484222325ULL ^ seed;
+
+  for (unsigned char ch : name) {
+    value ^= ch;
+    value *= 0x100000001b3ULL;
+  }
+
+  return mix(value);
+}
+
+size_t NameIndex::get_slot(uint64_t hash, uint32_t displacement,
+                           size_t size) {
+  return mix(hash + displacement * 0x9e3779b97f4a7c15ULL) % size;
+}
+
+bool NameIndex::try_build(const std::vector<uint64_t> &hashes,
+                          const std::vector<uint32_t> &ids) {
+  const size_t size = hashes.size();
+  const size_t bucket_count = size / BUCKET_SIZE + 1;
+
+  // Buckets hold positions in hashes; the slots get the ids at them.
+  std::vector<std::vector<uint32_t>> buckets(bucket_count);
+  for (uint32_t key = 0; key < size; ++key) {
+    buckets[hashes[key] % bucket_count].push_back(key);
+  }
+
+  std::vector<uint32_t> order(bucket_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&buckets](auto lhs, auto rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  std::vector<uint32_t> displacements(bucket_count, 0);
+  std::vector<uint32_t> slots(size, EMPTY_SLOT);
+
+  std::vector<size_t> bucket_slots;
+  for (uint32_t bucket : order) {
+    const auto &keys = buckets[bucket];
+
+    if (keys.empty()) {
+      break;
+    }
+
+    bool placed = false;
+    for (uint32_t displacement = 0;
+         !placed && displacement < MAX_DISPLACEMENT; ++displacement) {
+      bucket_slots.clear();
+      placed = true;
+
+      for (uint32_t key : keys) {
+        size_t slot = get_slot(hashes[key], displacement, size);
+
+        if (slots[slot] != EMPTY_SLOT ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                bucket_slots.end()) {
+          placed = false;
+          break;
+        }
+
+        bucket_slots.push_back(slot);
+      }
+
+      if (placed) {
+        displacements[bucket] = displacement;
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+          slots[bucket_slots[i]] = ids[keys[i]];
+        }
+      }
+    }
+
+    if (!placed) {
+      return false;
+    }
+  }
+
+  displacements_ = std::move(displacements);
+  slots_ = std::move(slots);
+
+  return true;
+}
+
+void NameIndex::build(const std::vector<std::string_view> &names) {
+  clear();
+
+  if (names.empty()) {
+    return;
+  }
+
+  // A name given more than once is indexed with its first id, as the name
+  // maps keep the first entry; equal keys could never get distinct slots.
+  std::unordered_set<std::string_view> seen;
+  std::vector<uint32_t> ids;
+
+  seen.reserve(names.size());
+  ids.reserve(names.size());
+  for (uint32_t id = 0; id < names.size(); ++id) {
+    if (seen.insert(names[id]).second) {
+      ids.push_back(id);
+    }
+  }
+
+  std::vector<uint64_t> hashes(ids.size());
+
+  for (uint64_t attempt = 0; attempt < 16; ++attempt) {
+    seed_ = mix(DEFAULT_SEED + attempt);
+
+    std::transform(ids.begin(), ids.end(), hashes.begin(),
+                   [this, &names](uint32_t id) {
+                     return hash(names[id], seed_);
+                   });
+
+    if (try_build(hashes, ids)) {
+      return;
+    }
+  }
+
+  clear();
+  throw std::runtime_error("unable to build perfect hash for names");
+}
+
+void NameIndex::clear() {
+  seed_ = DEFAULT_SEED;
+  displacements_ = {};
+  slots_ = {};
+}
+
+std::optional<uint32_t> NameIndex::find(std::string_view name) const {
+  if (slots_.empty()) {
+    return std::nullopt;
+  }
+
+  const uint64_t name_hash = hash(name, seed_);
+  const uint32_t displacement =
+      displacements_[name_hash % displacements_.size()];
+
+  return slots_[get_slot(name_hash, displacement, slots_.size())];
+}
+
+bool NameIndex::empty() const { return slots_.empty(); }
+
+uint64_t NameIndex::get_seed() const { return seed_; }
+
+const FlatArray<uint32_t> &NameIndex::get_displacements() const {
+  return displacements_;
+}
+
+const FlatArray<uint32_t> &NameIndex::get_slots() const { return slots_; }
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "flat_array.h"
+
+namespace domain {
+
+// Static minimal perfect hash over a fixed set of names (CHD scheme: keys are
+// split into buckets, and every bucket gets a displacement that places all of
+// its keys into free slots). A lookup costs one string hash and one probe; the
+// caller confirms the candidate id with a single name comparison.
+class NameIndex {
+public:
+  NameIndex() = default;
+  NameIndex(uint64_t seed, FlatArray<uint32_t> displacements,
+            FlatArray<uint32_t> slots);
+
+  void build(const std::vector<std::string_view> &names);
+  void clear();
+
+  std::optional<uint32_t> find(std::string_view name) const;
+  bool empty() const;
+
+  uint64_t get_seed() const;
+  const FlatArray<uint32_t> &get_displacements() const;
+  const FlatArray<uint32_t> &get_slots() const;
+
+private:
+  static const uint64_t DEFAULT_SEED = 0x9e3779b97f4a7c15ULL;
+  static const uint32_t MAX_DISPLACEMENT = 1u << 20;
+  static const size_t BUCKET_SIZE = 4;
+
+  static uint64_t hash(std::string_view name, uint64_t seed);
+  static uint64_t mix(uint64_t value);
+  static size_t get_slot(uint64_t hash, uint32_t displacement, size_t size);
+
+  bool try_build(const std::vector<uint64_t> &hashes,
+                 const std::vector<uint32_t> &ids);
+
+  uint64_t seed_ = DEFAULT_SEED;
+  FlatArray<uint32_t> displacements_;
+  FlatArray<uint32_t> slots_;
+};
+
+} // end namespace domain
\ No newline at end of file
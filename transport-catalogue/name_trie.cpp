@@ -0,0 +1,231 @@
+#include "name_trie.h"
+
+#include <algorithm>
+#include <map>
+
+namespace domain {
+
+// Adds a byte to the code point being decoded, pending being the number of
+// its bytes still to come; returns whether the code point is complete. A
+// byte that cannot continue or start a sequence is a code point of its own.
+static bool decode_utf8(unsigned char byte, char32_t &code_point,
+                        int &pending) {
+  if (pending > 0 && (byte & 0xC0) == 0x80) {
+    code_point = (code_point << 6) | (byte & 0x3F);
+    return --pending == 0;
+  }
+
+  if ((byte & 0xE0) == 0xC0) {
+    code_point = byte & 0x1F;
+    pending = 1;
+  } else if ((byte & 0xF0) == 0xE0) {
+    code_point = byte & 0x0F;
+    pending = 2;
+  } else if ((byte & 0xF8) == 0xF0) {
+    code_point = byte & 0x07;
+    pending = 3;
+  } else {
+    code_point = byte;
+    pending = 0;
+  }
+
+  return pending == 0;
+}
+
+NameTrie::NameTrie(FlatArray<char> labels, FlatArray<uint32_t> children_begin,
+                   FlatArray<uint32_t> values)
+    : labels_(std::move(labels)), children_begin_(std::move(children_begin)),
+      values_(std::move(values)) {}
+
+void NameTrie::build(const std::vector<std::string_view> &names) {
+  struct Node {
+    std::map<unsigned char, uint32_t> children;
+    uint32_t value = NO_VALUE;
+  };
+
+  std::vector<Node> nodes(1);
+
+  for (uint32_t id = 0; id < names.size(); ++id) {
+    uint32_t node = 0;
+
+    for (unsigned char label : names[id]) {
+      auto it = nodes[node].children.find(label);
+
+      if (it == nodes[node].children.end()) {
+        nodes[node].children[label] = static_cast<uint32_t>(nodes.size());
+        node = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+      } else {
+        node = it->second;
+      }
+    }
+
+    if (nodes[node].value == NO_VALUE) {
+      nodes[node].value = id;
+    }
+  }
+
+  std::vector<uint32_t> order{0};
+  std::vector<char> labels{'\0'};
+  std::vector<uint32_t> children_begin;
+  std::vector<uint32_t> values{nodes[0].value};
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    children_begin.push_back(static_cast<uint32_t>(order.size()));
+
+    for (auto [label, child] : nodes[order[i]].children) {
+      order.push_back(child);
+      labels.push_back(static_cast<char>(label));
+      values.push_back(nodes[child].value);
+    }
+  }
+
+  children_begin.push_back(static_cast<uint32_t>(order.size()));
+
+  labels_ = std::move(labels);
+  children_begin_ = std::move(children_begin);
+  values_ = std::move(values);
+}
+
+uint32_t NameTrie::find_child(uint32_t node, char label) const {
+  const auto first = labels_.begin() + children_begin_[node];
+  const auto last = labels_.begin() + children_begin_[node + 1];
+
+  const auto it = std::lower_bound(first, last, label, [](char lhs, char rhs) {
+    return static_cast<unsigned char>(lhs) < static_cast<unsigned char>(rhs);
+  });
+
+  return it != last && *it == label ? static_cast<uint32_t>(
+                                          it - labels_.begin())
+                                    : NO_VALUE;
+}
+
+std::vector<uint32_t> NameTrie::find_prefix(std::string_view prefix,
+                                            size_t limit) const {
+  std::vector<uint32_t> result;
+
+  if (empty()) {
+    return result;
+  }
+
+  uint32_t node = 0;
+  for (char label : prefix) {
+    node = find_child(node, label);
+
+    if (node == NO_VALUE) {
+      return result;
+    }
+  }
+
+  std::vector<uint32_t> stack{node};
+
+  while (!stack.empty() && result.size() < limit) {
+    node = stack.back();
+    stack.pop_back();
+
+    if (values_[node] != NO_VALUE) {
+      result.push_back(values_[node]);
+    }
+
+    for (uint32_t child = children_begin_[node + 1];
+         child > children_begin_[node]; --child) {
+      stack.push_back(child - 1);
+    }
+  }
+
+  return result;
+}
+
+// Labels are bytes, so the row of the DP advances only at the node where
+// a code point of the names ends; the nodes inside a multibyte sequence
+// pass the row on together with the partly decoded code point.
+void NameTrie::collect_similar(
+    uint32_t node, const std::vector<char32_t> &name,
+    const std::vector<size_t> &row, char32_t code_point, int pending,
+    size_t max_edits, std::vector<std::pair<size_t, uint32_t>> &result) const {
+  std::vector<size_t> next_row(row.size());
+
+  for (uint32_t child = children_begin_[node];
+       child < children_begin_[node + 1]; ++child) {
+    char32_t child_code_point = code_point;
+    int child_pending = pending;
+
+    if (!decode_utf8(static_cast<unsigned char>(labels_[child]),
+                     child_code_point, child_pending)) {
+      collect_similar(child, name, row, child_code_point, child_pending,
+                      max_edits, result);
+      continue;
+    }
+
+    next_row[0] = row[0] + 1;
+
+    for (size_t i = 1; i < row.size(); ++i) {
+      const size_t replace = row[i - 1] + (name[i - 1] != child_code_point);
+      next_row[i] = std::min({row[i] + 1, next_row[i - 1] + 1, replace});
+    }
+
+    if (values_[child] != NO_VALUE && next_row.back() <= max_edits) {
+      result.emplace_back(next_row.back(), values_[child]);
+    }
+
+    if (*std::min_element(next_row.begin(), next_row.end()) <= max_edits) {
+      collect_similar(child, name, next_row, 0, 0, max_edits, result);
+    }
+  }
+}
+
+std::vector<uint32_t> NameTrie::find_similar(std::string_view name,
+                                             size_t max_edits,
+                                             size_t limit) const {
+  std::vector<uint32_t> result;
+
+  if (empty()) {
+    return result;
+  }
+
+  std::vector<char32_t> code_points;
+  char32_t code_point = 0;
+  int pending = 0;
+
+  for (unsigned char byte : name) {
+    if (decode_utf8(byte, code_point, pending)) {
+      code_points.push_back(code_point);
+    }
+  }
+
+  std::vector<size_t> row(code_points.size() + 1);
+  for (size_t i = 0; i < row.size(); ++i) {
+    row[i] = i;
+  }
+
+  std::vector<std::pair<size_t, uint32_t>> matches;
+
+  if (values_[0] != NO_VALUE && code_points.size() <= max_edits) {
+    matches.emplace_back(code_points.size(), values_[0]);
+  }
+  collect_similar(0, code_points, row, 0, 0, max_edits, matches);
+
+  std::stable_sort(matches.begin(), matches.end(),
+                   [](const auto &lhs, const auto &rhs) {
+                     return lhs.first < rhs.first;
+                   });
+
+  for (size_t i = 0; i < matches.size() && i < limit; ++i) {
+    result.push_back(matches[i].second);
+  }
+
+  return result;
+}
+
+bool NameTrie::empty() const { return children_begin_.empty(); }
+
+const FlatArray<char> &NameTrie::get_labels() const { return labels_; }
+
+const FlatArray<uint32_t> &NameTrie::get_children_begin() const {
+  return children_begin_;
+}
+
+const FlatArray<uint32_t> &NameTrie::get_values() const { return values_; }
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flat_array.h"
+
+namespace domain {
+
+// Ordered index over a fixed set of names for autocomplete. The trie is
+// packed in breadth-first order: the children of a node are consecutive and
+// sorted by label, so a node is just its incoming label, the start of its
+// children and the id of the name ending in it. Walking the children in order
+// yields names in lexicographic order.
+class NameTrie {
+public:
+  NameTrie() = default;
+  NameTrie(FlatArray<char> labels, FlatArray<uint32_t> children_begin,
+           FlatArray<uint32_t> values);
+
+  void build(const std::vector<std::string_view> &names);
+
+  // Ids of names starting with prefix, in lexicographic order of the names.
+  std::vector<uint32_t> find_prefix(std::string_view prefix,
+                                    size_t limit) const;
+  // Ids of names within max_edits Levenshtein edits from name, closest
+  // first and lexicographic among equally close ones. Edits are counted in
+  // UTF-8 code points, so a Cyrillic letter is one edit and not two.
+  std::vector<uint32_t> find_similar(std::string_view name, size_t max_edits,
+                                     size_t limit) const;
+
+  bool empty() const;
+
+  const FlatArray<char> &get_labels() const;
+  const FlatArray<uint32_t> &get_children_begin() const;
+  const FlatArray<uint32_t> &get_values() const;
+
+private:
+  static const uint32_t NO_VALUE = std::numeric_limits<uint32_t>::max();
+
+  uint32_t find_child(uint32_t node, char label) const;
+  void collect_similar(uint32_t node, const std::vector<char32_t> &name,
+                       const std::vector<size_t> &row, char32_t code_point,
+                       int pending, size_t max_edits,
+                       std::vector<std::pair<size_t, uint32_t>> &result) const;
+
+  FlatArray<char> labels_;
+  FlatArray<uint32_t> children_begin_;
+  FlatArray<uint32_t> values_;
+};
+
+} // end namespace domain
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "network_stats.h"
+
+#include <algorithm>
+
+namespace domain {
+
+static bool is_ranked_before(const NetworkStats::Entry &lhs,
+                             const NetworkStats::Entry &rhs) {
+  return lhs.value != rhs.value ? lhs.value > rhs.value : lhs.name < rhs.name;
+}
+
+void NetworkStats::add_to_histogram(std::vector<uint64_t> &histogram,
+                                    size_t index, int64_t delta) {
+  if (histogram.size() <= index) {
+    histogram.resize(index + 1, 0);
+  }
+
+  histogram[index] += delta;
+
+  while (!histogram.empty() && histogram.back() == 0) {
+    histogram.pop_back();
+  }
+}
+
+void NetworkStats::rank(std::vector<Entry> &ranking, size_t count,
+                        Entry entry) {
+  auto it = std::find_if(ranking.begin(), ranking.end(),
+                         [&entry](const Entry &ranked) {
+                           return ranked.name == entry.name;
+                         });
+
+  if (it != ranking.end()) {
+    if (entry.value < it->value && count > ranking.size()) {
+      stale_ = true;
+    }
+    ranking.erase(it);
+
+  } else if (ranking.size() == TOP_SIZE &&
+             !is_ranked_before(entry, ranking.back())) {
+    return;
+  }
+
+  ranking.insert(std::upper_bound(ranking.begin(), ranking.end(), entry,
+                                  is_ranked_before),
+                 entry);
+
+  if (ranking.size() > TOP_SIZE) {
+    ranking.pop_back();
+  }
+}
+
+void NetworkStats::unrank(std::vector<Entry> &ranking, size_t count,
+                          std::string_view name) {
+  auto it = std::find_if(
+      ranking.begin(), ranking.end(),
+      [name](const Entry &ranked) { return ranked.name == name; });
+
+  if (it != ranking.end()) {
+    ranking.erase(it);
+
+    if (count > ranking.size()) {
+      stale_ = true;
+    }
+  }
+}
+
+void NetworkStats::add_stop(std::string_view name) {
+  ++stop_count_;
+  add_to_histogram(stop_bus_count_histogram_, 0, 1);
+  rank(busiest_stops_, stop_count_, {name, 0});
+}
+
+void NetworkStats::remove_stop(std::string_view name, size_t bus_count) {
+  --stop_count_;
+  add_to_histogram(stop_bus_count_histogram_, bus_count, -1);
+  unrank(busiest_stops_, stop_count_, name);
+}
+
+void NetworkStats::update_stop(std::string_view name, size_t old_bus_count,
+                               size_t bus_count) {
+  add_to_histogram(stop_bus_count_histogram_, old_bus_count, -1);
+  add_to_histogram(stop_bus_count_histogram_, bus_count, 1);
+  rank(busiest_stops_, stop_count_, {name, bus_count});
+}
+
+void NetworkStats::add_bus(std::string_view name, size_t route_length,
+                           double geo_length) {
+  ++bus_count_;
+  total_route_length_ += route_length;
+
+  if (geo_length > 0.) {
+    total_curvature_ += route_length / geo_length;
+    ++curvature_count_;
+  }
+
+  add_to_histogram(route_length_histogram_, route_length / LENGTH_BUCKET, 1);
+  rank(longest_buses_, bus_count_, {name, route_length});
+}
+
+void NetworkStats::remove_bus(std::string_view name, size_t route_length,
+                              double geo_length) {
+  --bus_count_;
+  total_route_length_ -= route_length;
+
+  if (geo_length > 0.) {
+    total_curvature_ -= route_length / geo_length;
+    --curvature_count_;
+  }
+
+  add_to_histogram(route_length_histogram_, route_length / LENGTH_BUCKET, -1);
+  unrank(longest_buses_, bus_count_, name);
+}
+
+void NetworkStats::update_bus(std::string_view name, size_t old_route_length,
+                              double old_geo_length, size_t route_length,
+                              double geo_length) {
+  total_route_length_ += route_length;
+  total_route_length_ -= old_route_length;
+
+  if (old_geo_length > 0.) {
+    total_curvature_ -= old_route_length / old_geo_length;
+    --curvature_count_;
+  }
+  if (geo_length > 0.) {
+    total_curvature_ += route_length / geo_length;
+    ++curvature_count_;
+  }
+
+  add_to_histogram(route_length_histogram_, old_route_length / LENGTH_BUCKET,
+                   -1);
+  add_to_histogram(route_length_histogram_, route_length / LENGTH_BUCKET, 1);
+  rank(longest_buses_, bus_count_, {name, route_length});
+}
+
+bool NetworkStats::is_stale() const { return stale_; }
+
+void NetworkStats::rebuild_rankings(std::vector<Entry> stops,
+                                    std::vector<Entry> buses) {
+  for (auto *entries : {&stops, &buses}) {
+    const size_t size = std::min(entries->size(), TOP_SIZE);
+
+    std::partial_sort(entries->begin(), entries->begin() + size,
+                      entries->end(), is_ranked_before);
+    entries->resize(size);
+  }
+
+  busiest_stops_ = std::move(stops);
+  longest_buses_ = std::move(buses);
+  stale_ = false;
+}
+
+size_t NetworkStats::get_stop_count() const { return stop_count_; }
+
+size_t NetworkStats::get_bus_count() const { return bus_count_; }
+
+uint64_t NetworkStats::get_total_route_length() const {
+  return total_route_length_;
+}
+
+double NetworkStats::get_average_curvature() const {
+  return curvature_count_ > 0 ? total_curvature_ / curvature_count_ : 0.;
+}
+
+const std::vector<NetworkStats::Entry> &
+NetworkStats::get_busiest_stops() const {
+  return busiest_stops_;
+}
+
+const std::vector<NetworkStats::Entry> &
+NetworkStats::get_longest_buses() const {
+  return longest_buses_;
+}
+
+const std::vector<uint64_t> &
+NetworkStats::get_stop_bus_count_histogram() const {
+  return stop_bus_count_histogram_;
+}
+
+const std::vector<uint64_t> &NetworkStats::get_route_length_histogram() const {
+  return route_length_histogram_;
+}
+
+double NetworkStats::get_total_curvature() const { return total_curvature_; }
+
+size_t NetworkStats::get_curvature_count() const { return curvature_count_; }
+
+void NetworkStats::set_counts(size_t stop_count, size_t bus_count,
+                              uint64_t total_route_length,
+                              double total_curvature, size_t curvature_count) {
+  stop_count_ = stop_count;
+  bus_count_ = bus_count;
+  total_route_length_ = total_route_length;
+  total_curvature_ = total_curvature;
+  curvature_count_ = curvature_count;
+}
+
+void NetworkStats::set_rankings(std::vector<Entry> busiest_stops,
+                                std::vector<Entry> longest_buses) {
+  busiest_stops_ = std::move(busiest_stops);
+  longest_buses_ = std::move(longest_buses);
+  stale_ = false;
+}
+
+void NetworkStats::set_histograms(
+    std::vector<uint64_t> stop_bus_count_histogram,
+    std::vector<uint64_t> route_length_histogram) {
+  stop_bus_count_histogram_ = std::move(stop_bus_count_histogram);
+  route_length_histogram_ = std::move(route_length_histogram);
+}
+
+} // end namespace domain
\ No newline at end of file
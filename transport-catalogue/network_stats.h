@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace domain {
+
+// Network-wide aggregates maintained by the catalogue on every change, so a
+// Network request only reads them. The rankings are bounded sorted lists of
+// TOP_SIZE entries; when an entry drops or leaves a full list some entity
+// outside of it may deserve the place, and the list is marked stale until
+// the owner rebuilds it from all entities.
+class NetworkStats {
+public:
+  static constexpr size_t TOP_SIZE = 10;
+  static const size_t LENGTH_BUCKET = 10000;
+
+  struct Entry {
+    std::string_view name;
+    uint64_t value = 0;
+  };
+
+  void add_stop(std::string_view name);
+  void remove_stop(std::string_view name, size_t bus_count);
+  void update_stop(std::string_view name, size_t old_bus_count,
+                   size_t bus_count);
+
+  void add_bus(std::string_view name, size_t route_length, double geo_length);
+  void remove_bus(std::string_view name, size_t route_length,
+                  double geo_length);
+  void update_bus(std::string_view name, size_t old_route_length,
+                  double old_geo_length, size_t route_length,
+                  double geo_length);
+
+  bool is_stale() const;
+  void rebuild_rankings(std::vector<Entry> stops, std::vector<Entry> buses);
+
+  size_t get_stop_count() const;
+  size_t get_bus_count() const;
+  uint64_t get_total_route_length() const;
+  double get_average_curvature() const;
+
+  const std::vector<Entry> &get_busiest_stops() const;
+  const std::vector<Entry> &get_longest_buses() const;
+
+  // Number of stops served by i buses, and of buses whose route length is in
+  // [i * LENGTH_BUCKET, (i + 1) * LENGTH_BUCKET) meters.
+  const std::vector<uint64_t> &get_stop_bus_count_histogram() const;
+  const std::vector<uint64_t> &get_route_length_histogram() const;
+
+  double get_total_curvature() const;
+  size_t get_curvature_count() const;
+
+  void set_counts(size_t stop_count, size_t bus_count,
+                  uint64_t total_route_length, double total_curvature,
+                  size_t curvature_count);
+  void set_rankings(std::vector<Entry> busiest_stops,
+                    std::vector<Entry> longest_buses);
+  void set_histograms(std::vector<uint64_t> stop_bus_count_histogram,
+                      std::vector<uint64_t> route_length_histogram);
+
+private:
+  static void add_to_histogram(std::vector<uint64_t> &histogram, size_t index,
+                               int64_t delta);
+
+  void rank(std::vector<Entry> &ranking, size_t count, Entry entry);
+  void unrank(std::vector<Entry> &ranking, size_t count,
+              std::string_view name);
+
+  size_t stop_count_ = 0;
+  size_t bus_count_ = 0;
+  uint64_t total_route_length_ = 0;
+  double total_curvature_ = 0.;
+  size_t curvature_count_ = 0;
+
+  std::vector<Entry> busiest_stops_;
+  std::vector<Entry> longest_buses_;
+  bool stale_ = false;
+
+  std::vector<uint64_t> stop_bus_count_histogram_;
+  std::vector<uint64_t> route_length_histogram_;
+};
+
+} // end namespace domain
\ No newline at end of file
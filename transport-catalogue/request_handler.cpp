@@ -2,6 +2,24 @@
 
 namespace request_handler {
 
+RequestMix inspect_requests(const std::vector<StatRequest> &stat_requests) {
+  RequestMix mix;
+
+  for (const StatRequest &req : stat_requests) {
+    if (req.type == "Stop") {
+      mix.has_stop = true;
+    } else if (req.type == "Bus") {
+      mix.has_bus = true;
+    } else if (req.type == "Map") {
+      mix.has_map = true;
+    } else if (req.type == "Route") {
+      mix.has_route = true;
+    }
+  }
+
+  return mix;
+}
+
 struct EdgeInfoGetter {
 
   Node operator()(const StopEdge &edge_info) {
@@ -62,8 +80,8 @@ Node RequestHandler::execute_make_node_stop(int id_request,
         .key("buses")
         .start_array();
 
-    for (std::string bus_name : stop_info.buses_name) {
-      builder.value(bus_name);
+    for (std::string_view bus_name : stop_info.buses_name) {
+      builder.value(std::string(bus_name));
     }
 
     builder.end_array().end_dict();
@@ -108,13 +126,9 @@ Node RequestHandler::execute_make_node_bus(int id_request,
   return result;
 }
 
-Node RequestHandler::execute_make_node_map(int id_request,
-                                           TransportCatalogue &catalogue_,
-                                           RenderSettings render_settings) {
-  Node result;
-
+std::string RequestHandler::render_map(const FrozenCatalogue &catalogue_,
+                                       RenderSettings render_settings) const {
   std::ostringstream map_stream;
-  std::string map_str;
 
   MapRenderer map_catalogue(render_settings);
 
@@ -122,14 +136,99 @@ Node RequestHandler::execute_make_node_map(int id_request,
 
   execute_render_map(map_catalogue, catalogue_);
   map_catalogue.get_stream_map(map_stream);
-  map_str = map_stream.str();
+
+  return map_stream.str();
+}
+
+void RequestHandler::set_prerendered_map(std::string map) {
+  prerendered_map_ = std::move(map);
+}
+
+// Prints an answer built with request_id 0 and cuts the value out; returns
+// the text and the position to splice a request id in at.
+static std::pair<std::string, uint32_t> cut_request_id(const Node &answer) {
+  static const std::string_view REQUEST_ID = "\"request_id\": 0";
+
+  std::ostringstream out;
+  print(Document{answer}, out);
+
+  std::string text = out.str();
+  const size_t id_position = text.find(REQUEST_ID) + REQUEST_ID.size() - 1;
+
+  text.erase(id_position, 1);
+
+  return {std::move(text), static_cast<uint32_t>(id_position)};
+}
+
+AnswerTable
+RequestHandler::precompute_stop_answers(const FrozenCatalogue &catalogue) {
+  std::vector<std::string> answers;
+  std::vector<uint32_t> id_positions;
+
+  answers.reserve(catalogue.get_stops().size());
+  id_positions.reserve(catalogue.get_stops().size());
+
+  for (const FrozenStop &stop : catalogue.get_stops()) {
+    auto [text, id_position] = cut_request_id(execute_make_node_stop(
+        0, stop_query(catalogue, catalogue.get_name(stop.name))));
+
+    answers.push_back(std::move(text));
+    id_positions.push_back(id_position);
+  }
+
+  AnswerTable table;
+  table.build(answers, std::move(id_positions));
+
+  return table;
+}
+
+AnswerTable
+RequestHandler::precompute_bus_answers(const FrozenCatalogue &catalogue) {
+  std::vector<std::string> answers;
+  std::vector<uint32_t> id_positions;
+
+  answers.reserve(catalogue.get_buses().size());
+  id_positions.reserve(catalogue.get_buses().size());
+
+  for (const FrozenBus &bus : catalogue.get_buses()) {
+    auto [text, id_position] = cut_request_id(execute_make_node_bus(
+        0, bus_query(catalogue, catalogue.get_name(bus.name))));
+
+    answers.push_back(std::move(text));
+    id_positions.push_back(id_position);
+  }
+
+  AnswerTable table;
+  table.build(answers, std::move(id_positions));
+
+  return table;
+}
+
+void RequestHandler::set_precomputed_answers(AnswerTable stop_answers,
+                                             AnswerTable bus_answers) {
+  stop_answers_ = std::move(stop_answers);
+  bus_answers_ = std::move(bus_answers);
+}
+
+void RequestHandler::set_route_table(const graph::RouteTable *route_table) {
+  route_table_ = route_table;
+}
+
+Node RequestHandler::execute_make_node_map(int id_request,
+                                           const FrozenCatalogue &catalogue_,
+                                           RenderSettings render_settings) {
+  Node result;
+
+  std::string map_str = prerendered_map_.empty()
+                            ? render_map(catalogue_, render_settings)
+                            : prerendered_map_;
 
   result = Builder{}
                .start_dict()
                .key("request_id")
                .value(id_request)
                .key("map")
-               .value(map_str)
+               .value(std::move(map_str))
                .end_dict()
                .build();
 
@@ -137,8 +236,8 @@ Node RequestHandler::execute_make_node_map(int id_request,
 }
 
 Node RequestHandler::execute_make_node_route(StatRequest &request,
-                                             TransportCatalogue &catalogue,
-                                             TransportRouter &routing) {
+                                             const FrozenCatalogue &catalogue,
+                                             const TransportRouter &routing) {
   const auto &route_info =
       get_route_info(request.from, request.to, catalogue, routing);
 
@@ -170,7 +269,215 @@ Node RequestHandler::execute_make_node_route(StatRequest &request,
       .build();
 }
 
-void RequestHandler::execute_queries(TransportCatalogue &catalogue,
+Node RequestHandler::execute_make_node_nearest_stops(
+    StatRequest &request, const FrozenCatalogue &catalogue) {
+  if (request.count < 0) {
+    return Builder{}
+        .start_dict()
+        .key("request_id")
+        .value(request.id)
+        .key("error_message")
+        .value(std::string("invalid count"))
+        .end_dict()
+        .build();
+  }
+
+  Array stops;
+
+  for (auto [stop, distance] : catalogue.find_nearest_stops(
+           request.coordinates, static_cast<size_t>(request.count))) {
+    stops.emplace_back(Builder{}
+                           .start_dict()
+                           .key("name")
+                           .value(std::string(catalogue.get_name(stop->name)))
+                           .key("distance")
+                           .value(distance)
+                           .end_dict()
+                           .build());
+  }
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(request.id)
+      .key("stops")
+      .value(stops)
+      .end_dict()
+      .build();
+}
+
+Node RequestHandler::execute_make_node_stops_in_area(
+    StatRequest &request, const FrozenCatalogue &catalogue) {
+  Array stops;
+
+  for (const FrozenStop *stop : catalogue.find_stops_in_area(request.area)) {
+    stops.emplace_back(std::string(catalogue.get_name(stop->name)));
+  }
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(request.id)
+      .key("stops")
+      .value(stops)
+      .end_dict()
+      .build();
+}
+
+Node RequestHandler::execute_make_node_segment_length(
+    StatRequest &request, const FrozenCatalogue &catalogue) {
+  const FrozenBus *bus = catalogue.get_bus(request.name);
+  const int stops_count =
+      bus ? static_cast<int>(catalogue.get_bus_stops(*bus).size()) : 0;
+
+  if (request.from_index < 0 || request.from_index > request.to_index ||
+      request.to_index >= stops_count) {
+    return Builder{}
+        .start_dict()
+        .key("request_id")
+        .value(request.id)
+        .key("error_message")
+        .value(std::string("not found"))
+        .end_dict()
+        .build();
+  }
+
+  const size_t from = static_cast<size_t>(request.from_index);
+  const size_t to = static_cast<size_t>(request.to_index);
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(request.id)
+      .key("route_length")
+      .value(static_cast<int>(catalogue.get_road_length(*bus, from, to)))
+      .key("geo_length")
+      .value(catalogue.get_geo_length(*bus, from, to))
+      .end_dict()
+      .build();
+}
+
+Node RequestHandler::execute_make_node_stop_search(
+    StatRequest &request, const FrozenCatalogue &catalogue) {
+  Array stops;
+
+  for (const FrozenStop *stop : catalogue.find_stops_by_name(
+           request.name, static_cast<size_t>(std::max(request.max_edits, 0)),
+           static_cast<size_t>(std::max(request.limit, 0)))) {
+    stops.emplace_back(std::string(catalogue.get_name(stop->name)));
+  }
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(request.id)
+      .key("stops")
+      .value(stops)
+      .end_dict()
+      .build();
+}
+
+Node RequestHandler::execute_make_node_direct_buses(
+    StatRequest &request, const FrozenCatalogue &catalogue) {
+  const FrozenStop *from = catalogue.get_stop(request.from);
+  const FrozenStop *to = catalogue.get_stop(request.to);
+
+  if (!from || !to) {
+    return Builder{}
+        .start_dict()
+        .key("request_id")
+        .value(request.id)
+        .key("error_message")
+        .value(std::string("not found"))
+        .end_dict()
+        .build();
+  }
+
+  Array buses;
+
+  for (const FrozenBus *bus : catalogue.find_direct_buses(*from, *to)) {
+    buses.emplace_back(std::string(catalogue.get_name(bus->name)));
+  }
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(request.id)
+      .key("buses")
+      .value(buses)
+      .end_dict()
+      .build();
+}
+
+Node RequestHandler::execute_make_node_network(
+    int id_request, const FrozenCatalogue &catalogue) {
+  const NetworkStats &stats = catalogue.get_network_stats();
+
+  Array busiest_stops;
+  Array longest_buses;
+  Array stop_bus_counts;
+  Array route_lengths;
+
+  for (const auto &entry : stats.get_busiest_stops()) {
+    busiest_stops.emplace_back(Builder{}
+                                   .start_dict()
+                                   .key("name")
+                                   .value(std::string(entry.name))
+                                   .key("bus_count")
+                                   .value(static_cast<int>(entry.value))
+                                   .end_dict()
+                                   .build());
+  }
+
+  for (const auto &entry : stats.get_longest_buses()) {
+    longest_buses.emplace_back(Builder{}
+                                   .start_dict()
+                                   .key("name")
+                                   .value(std::string(entry.name))
+                                   .key("route_length")
+                                   .value(static_cast<int>(entry.value))
+                                   .end_dict()
+                                   .build());
+  }
+
+  for (auto count : stats.get_stop_bus_count_histogram()) {
+    stop_bus_counts.emplace_back(static_cast<int>(count));
+  }
+
+  for (auto count : stats.get_route_length_histogram()) {
+    route_lengths.emplace_back(static_cast<int>(count));
+  }
+
+  return Builder{}
+      .start_dict()
+      .key("request_id")
+      .value(id_request)
+      .key("stop_count")
+      .value(static_cast<int>(stats.get_stop_count()))
+      .key("bus_count")
+      .value(static_cast<int>(stats.get_bus_count()))
+      .key("total_route_length")
+      .value(static_cast<double>(stats.get_total_route_length()))
+      .key("average_curvature")
+      .value(stats.get_average_curvature())
+      .key("busiest_stops")
+      .value(busiest_stops)
+      .key("longest_buses")
+      .value(longest_buses)
+      .key("stop_bus_count_histogram")
+      .value(stop_bus_counts)
+      .key("route_length_histogram")
+      .start_dict()
+      .key("bucket_size")
+      .value(static_cast<int>(NetworkStats::LENGTH_BUCKET))
+      .key("counts")
+      .value(route_lengths)
+      .end_dict()
+      .end_dict()
+      .build();
+}
+
+void RequestHandler::execute_queries(const FrozenCatalogue &catalogue,
                                      std::vector<StatRequest> &stat_requests,
                                      RenderSettings &render_settings,
                                      RoutingSettings &routing_settings) {
@@ -178,18 +485,43 @@ void RequestHandler::execute_queries(TransportCatalogue &catalogue,
   std::vector<Node> result_request;
   TransportRouter transport_router;
 
-  transport_router.set_routing_settings(routing_settings);
-  transport_router.build_router(catalogue);
+  // Building the router dominates the run on a large network, and only
+  // Route requests use it.
+  if (inspect_requests(stat_requests).has_route) {
+    transport_router.set_routing_settings(routing_settings);
+
+    if (route_table_) {
+      transport_router.build_router(catalogue, *route_table_);
+    } else {
+      transport_router.build_router(catalogue);
+    }
+  }
 
   for (StatRequest req : stat_requests) {
 
     if (req.type == "Stop") {
-      result_request.push_back(
-          execute_make_node_stop(req.id, stop_query(catalogue, req.name)));
+      const FrozenStop *stop =
+          stop_answers_.empty() ? nullptr : catalogue.get_stop(req.name);
+
+      if (stop) {
+        result_request.push_back(RawJson{
+            stop_answers_.get(catalogue.get_stop_id(*stop), req.id)});
+      } else {
+        result_request.push_back(
+            execute_make_node_stop(req.id, stop_query(catalogue, req.name)));
+      }
 
     } else if (req.type == "Bus") {
-      result_request.push_back(
-          execute_make_node_bus(req.id, bus_query(catalogue, req.name)));
+      const FrozenBus *bus =
+          bus_answers_.empty() ? nullptr : catalogue.get_bus(req.name);
+
+      if (bus) {
+        result_request.push_back(
+            RawJson{bus_answers_.get(catalogue.get_bus_id(*bus), req.id)});
+      } else {
+        result_request.push_back(
+            execute_make_node_bus(req.id, bus_query(catalogue, req.name)));
+      }
 
     } else if (req.type == "Map") {
       result_request.push_back(
@@ -198,16 +530,37 @@ void RequestHandler::execute_queries(TransportCatalogue &catalogue,
     } else if (req.type == "Route") {
       result_request.push_back(
           execute_make_node_route(req, catalogue, transport_router));
+
+    } else if (req.type == "NearestStops") {
+      result_request.push_back(
+          execute_make_node_nearest_stops(req, catalogue));
+
+    } else if (req.type == "StopsInArea") {
+      result_request.push_back(
+          execute_make_node_stops_in_area(req, catalogue));
+
+    } else if (req.type == "SegmentLength") {
+      result_request.push_back(
+          execute_make_node_segment_length(req, catalogue));
+
+    } else if (req.type == "StopSearch") {
+      result_request.push_back(execute_make_node_stop_search(req, catalogue));
+
+    } else if (req.type == "DirectBuses") {
+      result_request.push_back(execute_make_node_direct_buses(req, catalogue));
+
+    } else if (req.type == "Network") {
+      result_request.push_back(execute_make_node_network(req.id, catalogue));
     }
   }
 
   doc_out = Document{Node(result_request)};
 }
 
-void RequestHandler::execute_render_map(MapRenderer &map_catalogue,
-                                        TransportCatalogue &catalogue) const {
-  std::vector<std::pair<Bus *, int>> buses_palette;
-  std::vector<Stop *> stops_sort;
+void RequestHandler::execute_render_map(
+    MapRenderer &map_catalogue, const FrozenCatalogue &catalogue) const {
+  std::vector<std::pair<const FrozenBus *, int>> buses_palette;
+  std::vector<const FrozenStop *> stops_sort;
   int palette_size = 0;
   int palette_index = 0;
 
@@ -218,14 +571,13 @@ void RequestHandler::execute_render_map(MapRenderer &map_catalogue,
     return;
   }
 
-  auto buses = catalogue.get_busname_to_bus();
-  if (buses.size() > 0) {
+  if (catalogue.get_buses().size() > 0) {
 
     for (std::string_view bus_name : get_sort_buses_names(catalogue)) {
-      Bus *bus_info = catalogue.get_bus(bus_name);
+      const FrozenBus *bus_info = catalogue.get_bus(bus_name);
 
       if (bus_info) {
-        if (bus_info->stops.size() > 0) {
+        if (bus_info->stops_end > bus_info->stops_begin) {
           buses_palette.push_back(std::make_pair(bus_info, palette_index));
           palette_index++;
 
@@ -237,76 +589,71 @@ void RequestHandler::execute_render_map(MapRenderer &map_catalogue,
     }
 
     if (buses_palette.size() > 0) {
-      map_catalogue.add_line(buses_palette);
-      map_catalogue.add_buses_name(buses_palette);
+      map_catalogue.add_line(catalogue, buses_palette);
+      map_catalogue.add_buses_name(catalogue, buses_palette);
     }
   }
 
-  auto stops = catalogue.get_stopname_to_stop();
+  const auto &stops = catalogue.get_stops();
   if (stops.size() > 0) {
-    std::vector<std::string_view> stops_name;
 
-    for (auto &[stop_name, stop] : stops) {
+    for (const FrozenStop &stop : stops) {
 
-      if (stop->buses.size() > 0) {
-        stops_name.push_back(stop_name);
+      if (stop.buses_end > stop.buses_begin) {
+        stops_sort.push_back(&stop);
       }
     }
 
-    std::sort(stops_name.begin(), stops_name.end());
-
-    for (std::string_view stop_name : stops_name) {
-      Stop *stop = catalogue.get_stop(stop_name);
-      if (stop) {
-        stops_sort.push_back(stop);
-      }
-    }
+    std::sort(stops_sort.begin(), stops_sort.end(),
+              [&catalogue](const FrozenStop *lhs, const FrozenStop *rhs) {
+                return catalogue.get_name(lhs->name) <
+                       catalogue.get_name(rhs->name);
+              });
 
     if (stops_sort.size() > 0) {
       map_catalogue.add_stops_circle(stops_sort);
-      map_catalogue.add_stops_name(stops_sort);
+      map_catalogue.add_stops_name(catalogue, stops_sort);
     }
   }
 }
 
 std::optional<RouteInfo>
 RequestHandler::get_route_info(std::string_view start, std::string_view end,
-                               TransportCatalogue &catalogue,
-                               TransportRouter &routing) const {
+                               const FrozenCatalogue &catalogue,
+                               const TransportRouter &routing) const {
 
   return routing.get_route_info(
-      routing.get_router_by_stop(catalogue.get_stop(start))->bus_wait_start,
-      routing.get_router_by_stop(catalogue.get_stop(end))->bus_wait_start);
+      TransportRouter::get_router_by_stop(
+          catalogue.get_stop_id(*catalogue.get_stop(start)))
+          .bus_wait_start,
+      TransportRouter::get_router_by_stop(
+          catalogue.get_stop_id(*catalogue.get_stop(end)))
+          .bus_wait_start);
 }
 
-std::vector<geo::Coordinates>
-RequestHandler::get_stops_coordinates(TransportCatalogue &catalogue_) const {
+std::vector<geo::Coordinates> RequestHandler::get_stops_coordinates(
+    const FrozenCatalogue &catalogue_) const {
 
   std::vector<geo::Coordinates> stops_coordinates;
-  auto buses = catalogue_.get_busname_to_bus();
-
-  for (auto &[busname, bus] : buses) {
 
-    for (auto &stop : bus->stops) {
-      geo::Coordinates coordinates;
-      coordinates.latitude = stop->latitude;
-      coordinates.longitude = stop->longitude;
+  for (const FrozenBus &bus : catalogue_.get_buses()) {
 
-      stops_coordinates.push_back(coordinates);
+    for (uint32_t stop_id : catalogue_.get_bus_stops(bus)) {
+      stops_coordinates.push_back(catalogue_.get_stops()[stop_id].coordinates);
     }
   }
   return stops_coordinates;
 }
 
-std::vector<std::string_view>
-RequestHandler::get_sort_buses_names(TransportCatalogue &catalogue_) const {
+std::vector<std::string_view> RequestHandler::get_sort_buses_names(
+    const FrozenCatalogue &catalogue_) const {
   std::vector<std::string_view> buses_names;
 
-  auto buses = catalogue_.get_busname_to_bus();
+  const auto &buses = catalogue_.get_buses();
   if (buses.size() > 0) {
 
-    for (auto &[busname, bus] : buses) {
-      buses_names.push_back(busname);
+    for (const FrozenBus &bus : buses) {
+      buses_names.push_back(catalogue_.get_name(bus.name));
     }
 
     std::sort(buses_names.begin(), buses_names.end());
@@ -318,20 +665,19 @@ RequestHandler::get_sort_buses_names(TransportCatalogue &catalogue_) const {
   }
 }
 
-BusQueryResult RequestHandler::bus_query(TransportCatalogue &catalogue,
-                                         std::string_view bus_name) {
+BusQueryResult RequestHandler::bus_query(const FrozenCatalogue &catalogue,
+                                         std::string_view bus_name) const {
   BusQueryResult bus_info;
-  Bus *bus = catalogue.get_bus(bus_name);
+  const FrozenBus *bus = catalogue.get_bus(bus_name);
 
   if (bus != nullptr) {
-    bus_info.name = bus->name;
+    bus_info.name = catalogue.get_name(bus->name);
     bus_info.not_found = false;
-    bus_info.stops_on_route = static_cast<int>(bus->stops.size());
-    bus_info.unique_stops =
-        static_cast<int>(catalogue.get_uniq_stops(bus).size());
+    bus_info.stops_on_route =
+        static_cast<int>(catalogue.get_bus_stops(*bus).size());
+    bus_info.unique_stops = static_cast<int>(bus->unique_stops);
     bus_info.route_length = static_cast<int>(bus->route_length);
-    bus_info.curvature =
-        double(catalogue.get_distance_to_bus(bus) / catalogue.get_length(bus));
+    bus_info.curvature = catalogue.get_curvature(*bus);
   } else {
     bus_info.name = bus_name;
     bus_info.not_found = true;
@@ -340,25 +686,19 @@ BusQueryResult RequestHandler::bus_query(TransportCatalogue &catalogue,
   return bus_info;
 }
 
-StopQueryResult RequestHandler::stop_query(TransportCatalogue &catalogue,
-                                           std::string_view stop_name) {
-  std::unordered_set<const Bus *> unique_buses;
+StopQueryResult RequestHandler::stop_query(const FrozenCatalogue &catalogue,
+                                           std::string_view stop_name) const {
   StopQueryResult stop_info;
-  Stop *stop = catalogue.get_stop(stop_name);
+  const FrozenStop *stop = catalogue.get_stop(stop_name);
 
-  if (stop != NULL) {
+  if (stop != nullptr) {
 
-    stop_info.name = stop->name;
+    stop_info.name = catalogue.get_name(stop->name);
     stop_info.not_found = false;
-    unique_buses = catalogue.stop_get_uniq_buses(stop);
-
-    if (unique_buses.size() > 0) {
-
-      for (const Bus *bus : unique_buses) {
-        stop_info.buses_name.push_back(bus->name);
-      }
 
-      std::sort(stop_info.buses_name.begin(), stop_info.buses_name.end());
+    for (uint32_t bus_id : catalogue.get_stop_buses(*stop)) {
+      stop_info.buses_name.push_back(
+          catalogue.get_name(catalogue.get_buses()[bus_id].name));
     }
 
   } else {
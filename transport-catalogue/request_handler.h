@@ -1,5 +1,6 @@
 #pragma once
 
+#include "answer_table.h"
 #include "json_builder.h"
 #include "map_renderer.h"
 #include "transport_catalogue.h"
@@ -13,46 +14,91 @@ using namespace transport_catalogue::detail::router;
 
 namespace request_handler {
 
+// Kinds of requests in a batch, found before the base is loaded so that
+// only what they use is read and built.
+struct RequestMix {
+  bool has_stop = false;
+  bool has_bus = false;
+  bool has_map = false;
+  bool has_route = false;
+};
+
+RequestMix inspect_requests(const std::vector<StatRequest> &stat_requests);
+
 class RequestHandler {
 public:
   RequestHandler() = default;
 
   std::optional<RouteInfo> get_route_info(std::string_view start,
                                           std::string_view end,
-                                          TransportCatalogue &catalogue,
-                                          TransportRouter &routing) const;
+                                          const FrozenCatalogue &catalogue,
+                                          const TransportRouter &routing) const;
 
   std::vector<geo::Coordinates>
-  get_stops_coordinates(TransportCatalogue &catalogue_) const;
+  get_stops_coordinates(const FrozenCatalogue &catalogue_) const;
   std::vector<std::string_view>
-  get_sort_buses_names(TransportCatalogue &catalogue_) const;
+  get_sort_buses_names(const FrozenCatalogue &catalogue_) const;
+
+  BusQueryResult bus_query(const FrozenCatalogue &catalogue,
+                           std::string_view str) const;
+  StopQueryResult stop_query(const FrozenCatalogue &catalogue,
+                             std::string_view stop_name) const;
+
+  std::string render_map(const FrozenCatalogue &catalogue_,
+                         RenderSettings render_settings) const;
+  // A map rendered by make_base; Map requests answer with it instead of
+  // rendering the catalogue again.
+  void set_prerendered_map(std::string map);
+
+  // Answers to the Stop and Bus requests of every stop and bus, computed by
+  // make_base; requests for them are answered by splicing in the id.
+  AnswerTable precompute_stop_answers(const FrozenCatalogue &catalogue);
+  AnswerTable precompute_bus_answers(const FrozenCatalogue &catalogue);
+  void set_precomputed_answers(AnswerTable stop_answers,
+                               AnswerTable bus_answers);
 
-  BusQueryResult bus_query(TransportCatalogue &catalogue, std::string_view str);
-  StopQueryResult stop_query(TransportCatalogue &catalogue,
-                             std::string_view stop_name);
+  // Route requests take their routes from the table, which must outlive the
+  // handler, instead of computing them.
+  void set_route_table(const graph::RouteTable *route_table);
 
   Node execute_make_node_stop(int id_request,
                               const StopQueryResult &query_result);
   Node execute_make_node_bus(int id_request,
                              const BusQueryResult &query_result);
-  Node execute_make_node_map(int id_request, TransportCatalogue &catalogue,
+  Node execute_make_node_map(int id_request, const FrozenCatalogue &catalogue,
                              RenderSettings render_settings);
   Node execute_make_node_route(StatRequest &request,
-                               TransportCatalogue &catalogue,
-                               TransportRouter &routing);
+                               const FrozenCatalogue &catalogue,
+                               const TransportRouter &routing);
+  Node execute_make_node_nearest_stops(StatRequest &request,
+                                       const FrozenCatalogue &catalogue);
+  Node execute_make_node_stops_in_area(StatRequest &request,
+                                       const FrozenCatalogue &catalogue);
+  Node execute_make_node_segment_length(StatRequest &request,
+                                        const FrozenCatalogue &catalogue);
+  Node execute_make_node_stop_search(StatRequest &request,
+                                     const FrozenCatalogue &catalogue);
+  Node execute_make_node_direct_buses(StatRequest &request,
+                                      const FrozenCatalogue &catalogue);
+  Node execute_make_node_network(int id_request,
+                                 const FrozenCatalogue &catalogue);
 
-  void execute_queries(TransportCatalogue &catalogue,
+  void execute_queries(const FrozenCatalogue &catalogue,
                        std::vector<StatRequest> &stat_requests,
                        RenderSettings &render_settings,
                        RoutingSettings &route_settings);
 
   void execute_render_map(MapRenderer &map_catalogue,
-                          TransportCatalogue &catalogue_) const;
+                          const FrozenCatalogue &catalogue_) const;
 
   const Document &get_document();
 
 private:
   Document doc_out;
+  std::string prerendered_map_;
+  AnswerTable stop_answers_;
+  AnswerTable bus_answers_;
+  const graph::RouteTable *route_table_ = nullptr;
 };
 
 } // end namespace request_handler
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "route_table.h"
+
+#include <stdexcept>
+
+namespace graph {
+
+bool RouteTable::open(const std::string &path) {
+  cells_ = nullptr;
+
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  const std::string_view data = file_.get_data();
+
+  if (data.size() < sizeof(header_)) {
+    throw std::runtime_error("route table is truncated");
+  }
+
+  std::memcpy(&header_, data.data(), sizeof(header_));
+
+  if (std::memcmp(header_.magic, RouteTableHeader::MAGIC,
+                  sizeof(header_.magic)) != 0) {
+    throw std::runtime_error("file is not a route table");
+  }
+
+  if (header_.version != RouteTableHeader::VERSION ||
+      header_.endianness != RouteTableHeader::ENDIANNESS) {
+    throw std::runtime_error("unsupported route table version or byte order");
+  }
+
+  if (data.size() - sizeof(header_) !=
+      header_.vertex_count * header_.vertex_count * sizeof(RouteCell)) {
+    throw std::runtime_error("route table is truncated");
+  }
+
+  cells_ = reinterpret_cast<const RouteCell *>(data.data() + sizeof(header_));
+
+  return true;
+}
+
+size_t RouteTable::get_vertex_count() const {
+  return static_cast<size_t>(header_.vertex_count);
+}
+
+size_t RouteTable::get_edge_count() const {
+  return static_cast<size_t>(header_.edge_count);
+}
+
+uint64_t RouteTable::get_graph_hash() const { return header_.graph_hash; }
+
+const RouteCell &RouteTable::get_cell(VertexId from, VertexId to) const {
+  return cells_[from * header_.vertex_count + to];
+}
+
+} // end namespace graph
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "graph.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace graph {
+
+// Layout of a route table file: the routes between all pairs of vertices of
+// a graph, written by Router::save next to the base. The header is followed
+// by a matrix of cells with one row per source vertex, so the routes from a
+// source are contiguous and a mapped table reads only the rows of the
+// sources asked about.
+struct RouteTableHeader {
+  static constexpr char MAGIC[8] = {'T', 'C', 'R', 'O', 'U', 'T', 'E', '\0'};
+  static const uint32_t VERSION = 1;
+  static const uint32_t ENDIANNESS = 0x01020304;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t endianness;
+  uint64_t vertex_count;
+  uint64_t edge_count;
+  // Hash of the edges the routes were computed on; see hash_graph.
+  uint64_t graph_hash;
+};
+
+// The best route from the source of a row to the target of a column: its
+// weight and its last edge, which leads to the cell of the previous vertex
+// in the same row.
+struct RouteCell {
+  static const uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
+  // Infinite if the target cannot be reached.
+  float weight;
+  uint32_t prev_edge;
+};
+
+class RouteTable {
+public:
+  // Returns false if the file cannot be opened; throws if it is not a route
+  // table this build can read.
+  bool open(const std::string &path);
+
+  size_t get_vertex_count() const;
+  size_t get_edge_count() const;
+  uint64_t get_graph_hash() const;
+
+  const RouteCell &get_cell(VertexId from, VertexId to) const;
+
+private:
+  domain::MappedFile file_;
+  RouteTableHeader header_{};
+  const RouteCell *cells_ = nullptr;
+};
+
+// FNV-1a hash of the ends and weights of all edges in order. A table is
+// used only with a graph of the same hash, since its cells refer to edges
+// by id.
+template <typename Weight>
+uint64_t hash_graph(const DirectedWeightedGraph<Weight> &graph) {
+  uint64_t hash = 14695981039346656037ULL;
+
+  const auto add = [&hash](const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+  };
+
+  for (EdgeId id = 0; id < graph.get_edge_count(); ++id) {
+    const auto &edge = graph.get_edge(id);
+    const uint64_t ends[2] = {edge.from, edge.to};
+
+    add(ends, sizeof(ends));
+    add(&edge.weight, sizeof(edge.weight));
+  }
+
+  return hash;
+}
+
+} // end namespace graph
\ No newline at end of file
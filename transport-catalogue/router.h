@@ -1,12 +1,17 @@
 #pragma once
 
 #include "graph.h"
+#include "route_table.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <limits>
 #include <optional>
+#include <ostream>
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
@@ -19,6 +24,9 @@ template <typename Weight> class Router {
 
 public:
   explicit Router(const Graph &graph);
+  // Takes the routes from a table written by save for the same graph
+  // instead of computing them. The table must outlive the router.
+  Router(const Graph &graph, const RouteTable &route_table);
 
   struct RouteInfo {
     Weight weight;
@@ -37,6 +45,9 @@ public:
 
   std::optional<RouteInfo> build_route(VertexId from, VertexId to) const;
 
+  // Writes the computed routes as a route table.
+  void save(std::ostream &out) const;
+
 private:
   struct RouteInternalData {
     Weight weight;
@@ -101,9 +112,13 @@ private:
     }
   }
 
+  std::optional<RouteInfo> build_route_from_table(VertexId from,
+                                                  VertexId to) const;
+
   static constexpr Weight ZERO_WEIGHT{};
   const Graph &graph_;
   RoutesInternalData routes_internal_data_;
+  const RouteTable *route_table_ = nullptr;
 };
 
 template <typename Weight>
@@ -121,9 +136,17 @@ Router<Weight>::Router(const Graph &graph)
   }
 }
 
+template <typename Weight>
+Router<Weight>::Router(const Graph &graph, const RouteTable &route_table)
+    : graph_(graph), route_table_(&route_table) {}
+
 template <typename Weight>
 std::optional<typename Router<Weight>::RouteInfo>
 Router<Weight>::build_route(VertexId from, VertexId to) const {
+  if (route_table_) {
+    return build_route_from_table(from, to);
+  }
+
   const auto &route_internal_data = routes_internal_data_.at(from).at(to);
 
   if (!route_internal_data) {
@@ -144,4 +167,77 @@ Router<Weight>::build_route(VertexId from, VertexId to) const {
   return RouteInfo{weight, std::move(edges)};
 }
 
+// A cell keeps the weight rounded to 32 bits, so the weight of a route is
+// summed from its edges; it is the same as that of a computed route.
+template <typename Weight>
+std::optional<typename Router<Weight>::RouteInfo>
+Router<Weight>::build_route_from_table(VertexId from, VertexId to) const {
+  if (from >= route_table_->get_vertex_count() ||
+      to >= route_table_->get_vertex_count()) {
+    throw std::out_of_range("vertex is out of the route table");
+  }
+
+  const RouteCell &cell = route_table_->get_cell(from, to);
+
+  if (std::isinf(cell.weight)) {
+    return std::nullopt;
+  }
+
+  std::vector<EdgeId> edges;
+  for (uint32_t edge_id = cell.prev_edge; edge_id != RouteCell::NO_EDGE;
+       edge_id =
+           route_table_->get_cell(from, graph_.get_edge(edge_id).from)
+               .prev_edge) {
+
+    edges.push_back(edge_id);
+  }
+
+  std::reverse(edges.begin(), edges.end());
+
+  Weight weight = ZERO_WEIGHT;
+  for (const EdgeId edge_id : edges) {
+    weight += graph_.get_edge(edge_id).weight;
+  }
+
+  return RouteInfo{weight, std::move(edges)};
+}
+
+template <typename Weight> void Router<Weight>::save(std::ostream &out) const {
+  const size_t vertex_count = graph_.get_vertex_count();
+
+  if (graph_.get_edge_count() >= RouteCell::NO_EDGE) {
+    throw std::length_error("too many edges for a route table");
+  }
+
+  RouteTableHeader header;
+
+  std::memcpy(header.magic, RouteTableHeader::MAGIC, sizeof(header.magic));
+  header.version = RouteTableHeader::VERSION;
+  header.endianness = RouteTableHeader::ENDIANNESS;
+  header.vertex_count = vertex_count;
+  header.edge_count = graph_.get_edge_count();
+  header.graph_hash = hash_graph(graph_);
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::vector<RouteCell> row(vertex_count);
+
+  for (VertexId from = 0; from < vertex_count; ++from) {
+    for (VertexId to = 0; to < vertex_count; ++to) {
+      const auto &route = routes_internal_data_[from][to];
+
+      if (!route) {
+        row[to] = {std::numeric_limits<float>::infinity(), RouteCell::NO_EDGE};
+      } else {
+        row[to] = {static_cast<float>(route->weight),
+                   route->prev_edge ? static_cast<uint32_t>(*route->prev_edge)
+                                    : RouteCell::NO_EDGE};
+      }
+    }
+
+    out.write(reinterpret_cast<const char *>(row.data()),
+              row.size() * sizeof(RouteCell));
+  }
+}
+
 } // end namespace graph
\ No newline at end of file
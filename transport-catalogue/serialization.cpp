@@ -1,134 +1,762 @@
 #include "serialization.h"
 
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace serialization {
 
-template <typename It>
-uint32_t calculate_id(It start, It end, std::string_view name) {
+transport_catalogue_protobuf::NameIndex
+name_index_serialization(const domain::NameIndex &name_index) {
+
+  transport_catalogue_protobuf::NameIndex name_index_proto;
+
+  name_index_proto.set_seed(name_index.get_seed());
+
+  for (auto displacement : name_index.get_displacements()) {
+    name_index_proto.add_displacements(displacement);
+  }
 
-  auto stop_it = std::find_if(start, end, [&name](const domain::Stop stop) {
-    return stop.name == name;
-  });
-  return std::distance(start, stop_it);
+  for (auto slot : name_index.get_slots()) {
+    name_index_proto.add_slots(slot);
+  }
+
+  return name_index_proto;
 }
 
-transport_catalogue_protobuf::TransportCatalogue
-transport_catalogue_serialization(
-    const transport_catalogue::TransportCatalogue &transport_catalogue) {
+domain::NameIndex name_index_deserialization(
+    const transport_catalogue_protobuf::NameIndex &name_index_proto) {
 
-  transport_catalogue_protobuf::TransportCatalogue transport_catalogue_proto;
+  return domain::NameIndex(
+      name_index_proto.seed(),
+      {name_index_proto.displacements().begin(),
+       name_index_proto.displacements().end()},
+      {name_index_proto.slots().begin(), name_index_proto.slots().end()});
+}
 
-  const auto &stops = transport_catalogue.get_stops();
-  const auto &buses = transport_catalogue.get_buses();
-  const auto &distances = transport_catalogue.get_distance();
+transport_catalogue_protobuf::NameTrie
+name_trie_serialization(const domain::NameTrie &name_trie) {
 
-  int id = 0;
-  for (const auto &stop : stops) {
+  transport_catalogue_protobuf::NameTrie name_trie_proto;
+
+  name_trie_proto.set_labels(name_trie.get_labels().data(),
+                             name_trie.get_labels().size());
+
+  for (auto children_begin : name_trie.get_children_begin()) {
+    name_trie_proto.add_children_begin(children_begin);
+  }
+
+  for (auto value : name_trie.get_values()) {
+    name_trie_proto.add_values(value);
+  }
+
+  return name_trie_proto;
+}
+
+domain::NameTrie name_trie_deserialization(
+    const transport_catalogue_protobuf::NameTrie &name_trie_proto) {
+
+  return domain::NameTrie({name_trie_proto.labels().begin(),
+                           name_trie_proto.labels().end()},
+                          {name_trie_proto.children_begin().begin(),
+                           name_trie_proto.children_begin().end()},
+                          {name_trie_proto.values().begin(),
+                           name_trie_proto.values().end()});
+}
+
+transport_catalogue_protobuf::NetworkStats
+network_stats_serialization(const domain::NetworkStats &network_stats,
+                            const domain::NameArena &names) {
+
+  transport_catalogue_protobuf::NetworkStats network_stats_proto;
+
+  network_stats_proto.set_stop_count(network_stats.get_stop_count());
+  network_stats_proto.set_bus_count(network_stats.get_bus_count());
+  network_stats_proto.set_total_route_length(
+      network_stats.get_total_route_length());
+  network_stats_proto.set_total_curvature(network_stats.get_total_curvature());
+  network_stats_proto.set_curvature_count(network_stats.get_curvature_count());
+
+  for (const auto &entry : network_stats.get_busiest_stops()) {
+    auto *entry_proto = network_stats_proto.add_busiest_stops();
+    entry_proto->set_name_offset(names.get_offset(entry.name));
+    entry_proto->set_name_size(entry.name.size());
+    entry_proto->set_value(entry.value);
+  }
+
+  for (const auto &entry : network_stats.get_longest_buses()) {
+    auto *entry_proto = network_stats_proto.add_longest_buses();
+    entry_proto->set_name_offset(names.get_offset(entry.name));
+    entry_proto->set_name_size(entry.name.size());
+    entry_proto->set_value(entry.value);
+  }
+
+  for (auto count : network_stats.get_stop_bus_count_histogram()) {
+    network_stats_proto.add_stop_bus_count_histogram(count);
+  }
+
+  for (auto count : network_stats.get_route_length_histogram()) {
+    network_stats_proto.add_route_length_histogram(count);
+  }
+
+  return network_stats_proto;
+}
+
+domain::NetworkStats network_stats_deserialization(
+    const transport_catalogue_protobuf::NetworkStats &network_stats_proto,
+    const domain::NameArena &names) {
 
-    transport_catalogue_protobuf::Stop stop_proto;
+  domain::NetworkStats network_stats;
+  std::vector<domain::NetworkStats::Entry> busiest_stops;
+  std::vector<domain::NetworkStats::Entry> longest_buses;
 
-    stop_proto.set_id(id);
-    stop_proto.set_name(stop.name);
+  for (const auto &entry_proto : network_stats_proto.busiest_stops()) {
+    busiest_stops.push_back(
+        {names.get_name(entry_proto.name_offset(), entry_proto.name_size()),
+         entry_proto.value()});
+  }
+
+  for (const auto &entry_proto : network_stats_proto.longest_buses()) {
+    longest_buses.push_back(
+        {names.get_name(entry_proto.name_offset(), entry_proto.name_size()),
+         entry_proto.value()});
+  }
+
+  network_stats.set_counts(
+      network_stats_proto.stop_count(), network_stats_proto.bus_count(),
+      network_stats_proto.total_route_length(),
+      network_stats_proto.total_curvature(),
+      network_stats_proto.curvature_count());
+  network_stats.set_rankings(std::move(busiest_stops),
+                             std::move(longest_buses));
+  network_stats.set_histograms(
+      {network_stats_proto.stop_bus_count_histogram().begin(),
+       network_stats_proto.stop_bus_count_histogram().end()},
+      {network_stats_proto.route_length_histogram().begin(),
+       network_stats_proto.route_length_histogram().end()});
+
+  return network_stats;
+}
+
+transport_catalogue_protobuf::SpatialIndex
+spatial_index_serialization(const domain::SpatialIndex &spatial_index) {
+
+  transport_catalogue_protobuf::SpatialIndex spatial_index_proto;
+
+  for (auto id : spatial_index.get_ids()) {
+    spatial_index_proto.add_ids(id);
+  }
+
+  for (const auto &box : spatial_index.get_boxes()) {
+    spatial_index_proto.add_boxes(box.min_latitude);
+    spatial_index_proto.add_boxes(box.min_longitude);
+    spatial_index_proto.add_boxes(box.max_latitude);
+    spatial_index_proto.add_boxes(box.max_longitude);
+  }
+
+  return spatial_index_proto;
+}
+
+domain::SpatialIndex spatial_index_deserialization(
+    const transport_catalogue_protobuf::SpatialIndex &spatial_index_proto) {
+
+  const auto &boxes_proto = spatial_index_proto.boxes();
+  std::vector<geo::BoundingBox> boxes;
+
+  boxes.reserve(boxes_proto.size() / 4);
+  for (int i = 0; i + 3 < boxes_proto.size(); i += 4) {
+    boxes.push_back({boxes_proto[i], boxes_proto[i + 1], boxes_proto[i + 2],
+                     boxes_proto[i + 3]});
+  }
+
+  return domain::SpatialIndex(
+      {spatial_index_proto.ids().begin(), spatial_index_proto.ids().end()},
+      std::move(boxes));
+}
+
+// Coordinates of a compact base are fixed-point numbers of 1e-7 degrees,
+// about a centimetre. Inputs given with up to seven decimals load back as
+// exactly the same doubles.
+static const double COORDINATE_SCALE = 1e7;
+
+static int64_t quantize_coordinate(double degrees) {
+  return std::llround(degrees * COORDINATE_SCALE);
+}
+
+static double restore_coordinate(int64_t value) {
+  return static_cast<double>(value) / COORDINATE_SCALE;
+}
+
+// Stops or buses per chunk of a base, and bytes per piece of the name blob
+// and of the map.
+static const size_t CHUNK_SIZE = 1 << 16;
+static const size_t PIECE_SIZE = 1 << 24;
+
+using StopIds = std::unordered_map<const domain::Stop *, uint32_t>;
+
+// Only the distances given in the input are written; the ways back they
+// serve are added again on load.
+static size_t count_given_distances(const domain::Stop &stop) {
+  return std::count_if(
+      stop.distances.begin(), stop.distances.end(),
+      [](const domain::RoadDistance &entry) { return entry.is_given; });
+}
+
+// Writes the stops [begin, end) with their road distances.
+static void stops_serialization(
+    const std::pmr::deque<domain::Stop> &stops, size_t begin, size_t end,
+    const domain::NameArena &names, const StopIds &stop_ids,
+    transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
+
+  chunk_proto.mutable_stops()->Reserve(end - begin);
+
+  // Messages are filled in place and reused from chunk to chunk, which
+  // spares allocating thousands of small Stop messages each time.
+  for (size_t i = begin; i < end; ++i) {
+
+    const auto &stop = stops[i];
+    transport_catalogue_protobuf::Stop &stop_proto = *chunk_proto.add_stops();
+
+    stop_proto.set_id(stop_ids.at(&stop));
+    stop_proto.set_name_offset(names.get_offset(stop.name));
+    stop_proto.set_name_size(stop.name.size());
     stop_proto.set_latitude(stop.latitude);
     stop_proto.set_longitude(stop.longitude);
+    stop_proto.set_distances_count(count_given_distances(stop));
+
+    for (const auto &[neighbour, distance, is_given] : stop.distances) {
+      if (is_given) {
+        chunk_proto.add_distance_stops(stop_ids.at(neighbour));
+        chunk_proto.add_distances(distance);
+      }
+    }
+  }
+}
 
-    *transport_catalogue_proto.add_stops() = std::move(stop_proto);
+static void compact_stops_serialization(
+    const std::pmr::deque<domain::Stop> &stops, size_t begin, size_t end,
+    const domain::NameArena &names, const StopIds &stop_ids,
+    transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
+
+  auto &stops_proto = *chunk_proto.mutable_compact_stops();
+  int64_t last_name_offset = 0;
+  int64_t last_latitude = 0;
+  int64_t last_longitude = 0;
+  std::vector<std::pair<uint32_t, int>> group;
+
+  stops_proto.mutable_name_offsets()->Reserve(end - begin);
+  stops_proto.mutable_name_sizes()->Reserve(end - begin);
+  stops_proto.mutable_latitudes()->Reserve(end - begin);
+  stops_proto.mutable_longitudes()->Reserve(end - begin);
+  stops_proto.mutable_distances_counts()->Reserve(end - begin);
+
+  for (size_t i = begin; i < end; ++i) {
+
+    const auto &stop = stops[i];
+    const int64_t name_offset = names.get_offset(stop.name);
+    const int64_t latitude = quantize_coordinate(stop.latitude);
+    const int64_t longitude = quantize_coordinate(stop.longitude);
+
+    stops_proto.add_name_offsets(name_offset - last_name_offset);
+    stops_proto.add_name_sizes(stop.name.size());
+    stops_proto.add_latitudes(latitude - last_latitude);
+    stops_proto.add_longitudes(longitude - last_longitude);
+    stops_proto.add_distances_counts(count_given_distances(stop));
+
+    last_name_offset = name_offset;
+    last_latitude = latitude;
+    last_longitude = longitude;
+
+    group.clear();
+    for (const auto &[neighbour, distance, is_given] : stop.distances) {
+      if (is_given) {
+        group.emplace_back(stop_ids.at(neighbour), distance);
+      }
+    }
+    std::sort(group.begin(), group.end());
 
-    ++id;
+    uint32_t last_neighbour = 0;
+    for (const auto &[neighbour, distance] : group) {
+      chunk_proto.add_distance_stops(neighbour - last_neighbour);
+      chunk_proto.add_distances(distance);
+      last_neighbour = neighbour;
+    }
   }
+}
 
-  for (const auto &bus : buses) {
+// Writes the buses [begin, end).
+static void buses_serialization(
+    const std::pmr::deque<domain::Bus> &buses, size_t begin, size_t end,
+    const domain::NameArena &names, const StopIds &stop_ids,
+    transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
 
-    transport_catalogue_protobuf::Bus bus_proto;
+  chunk_proto.mutable_buses()->Reserve(end - begin);
 
-    bus_proto.set_name(bus.name);
+  for (size_t i = begin; i < end; ++i) {
 
+    const auto &bus = buses[i];
+    transport_catalogue_protobuf::Bus &bus_proto = *chunk_proto.add_buses();
+
+    bus_proto.set_name_offset(names.get_offset(bus.name));
+    bus_proto.set_name_size(bus.name.size());
+
+    bus_proto.mutable_stops()->Reserve(bus.stops.size());
     for (auto stop : bus.stops) {
-      uint32_t stop_id = calculate_id(stops.cbegin(), stops.cend(), stop->name);
-      bus_proto.add_stops(stop_id);
+      bus_proto.add_stops(stop_ids.at(stop));
     }
 
     bus_proto.set_is_roundtrip(bus.is_roundtrip);
     bus_proto.set_route_length(bus.route_length);
+  }
+}
 
-    *transport_catalogue_proto.add_buses() = std::move(bus_proto);
+static void compact_buses_serialization(
+    const std::pmr::deque<domain::Bus> &buses, size_t begin, size_t end,
+    const domain::NameArena &names, const StopIds &stop_ids,
+    transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
+
+  auto &buses_proto = *chunk_proto.mutable_compact_buses();
+  int64_t last_name_offset = 0;
+
+  buses_proto.mutable_name_offsets()->Reserve(end - begin);
+  buses_proto.mutable_name_sizes()->Reserve(end - begin);
+  buses_proto.mutable_is_roundtrip()->Reserve(end - begin);
+  buses_proto.mutable_stops_counts()->Reserve(end - begin);
+
+  for (size_t i = begin; i < end; ++i) {
+
+    const auto &bus = buses[i];
+    const int64_t name_offset = names.get_offset(bus.name);
+
+    buses_proto.add_name_offsets(name_offset - last_name_offset);
+    buses_proto.add_name_sizes(bus.name.size());
+    buses_proto.add_is_roundtrip(bus.is_roundtrip);
+    buses_proto.add_stops_counts(bus.stops.size());
+
+    last_name_offset = name_offset;
+
+    int64_t last_stop = 0;
+    for (auto stop : bus.stops) {
+      const int64_t stop_id = stop_ids.at(stop);
+      buses_proto.add_stops(stop_id - last_stop);
+      last_stop = stop_id;
+    }
   }
+}
+
+namespace {
+
+// Parts of a base decoded independently of each other and stitched into
+// the catalogue afterwards; they refer to stops by id, the position of the
+// stop in the base.
+struct DecodedStop {
+  std::string_view name;
+  geo::Coordinates coordinates;
+};
+
+struct DecodedDistance {
+  uint32_t start;
+  uint32_t end;
+  int distance;
+};
+
+struct DecodedBus {
+  std::string_view name;
+  std::vector<uint32_t> stops;
+  bool is_roundtrip;
+};
+
+// Sums of the delta-coded fields of a compact chunk over the stops or
+// buses before a part of it, which the part starts decoding from.
+struct DeltaSums {
+  int64_t name_offset = 0;
+  int64_t latitude = 0;
+  int64_t longitude = 0;
+  int stop_index = 0;
+};
+
+// Fills a catalogue from the parts of a base in the order they are
+// written: the name blob, the indexes, chunks of stops and then chunks of
+// buses. Road distances may lead to stops of later chunks, so they are
+// added when the first buses or the end of the base arrive.
+class CatalogueLoader {
+public:
+  void add_names(std::string_view names);
+  void add_indexes(
+      const transport_catalogue_protobuf::TransportCatalogue &indexes_proto);
+  void add_stops(
+      const transport_catalogue_protobuf::TransportCatalogue &chunk_proto);
+  void add_buses(
+      const transport_catalogue_protobuf::TransportCatalogue &chunk_proto);
+
+  bool is_compact() const;
+  transport_catalogue::TransportCatalogue finish();
+
+private:
+  void finish_stops();
+
+  transport_catalogue::TransportCatalogue catalogue_;
+  std::string names_;
+  bool compact_ = false;
+  bool stops_finished_ = false;
+
+  std::vector<domain::Stop *> stops_;
+  std::vector<DecodedDistance> distances_;
+
+  // Leaf order of a spatial index saved without its boxes, and the
+  // coordinates to restore them from.
+  std::vector<uint32_t> spatial_ids_;
+  std::vector<geo::Coordinates> points_;
+
+  bool has_network_stats_ = false;
+  transport_catalogue_protobuf::NetworkStats network_stats_proto_;
+};
+
+} // end namespace
+
+// Number of parts a chunk is split into to be decoded in parallel.
+static int get_parts_count() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
 
-  for (const auto &[pair_stops, pair_distance] : distances) {
+// Decodes the stops [begin, end) of a chunk, given the sums of the stops
+// before begin.
+static std::vector<DecodedStop>
+decode_stops(const transport_catalogue_protobuf::TransportCatalogue
+                 &chunk_proto,
+             const domain::NameArena &names, int begin, int end,
+             DeltaSums sums) {
 
-    transport_catalogue_protobuf::Distance distance_proto;
+  std::vector<DecodedStop> stops;
 
-    distance_proto.set_start(
-        calculate_id(stops.cbegin(), stops.cend(), pair_stops.first->name));
+  stops.reserve(end - begin);
 
-    distance_proto.set_end(
-        calculate_id(stops.cbegin(), stops.cend(), pair_stops.second->name));
+  if (chunk_proto.has_compact_stops()) {
+    const auto &stops_proto = chunk_proto.compact_stops();
 
-    distance_proto.set_distance(pair_distance);
+    for (int i = begin; i < end; ++i) {
+      sums.name_offset += stops_proto.name_offsets(i);
+      sums.latitude += stops_proto.latitudes(i);
+      sums.longitude += stops_proto.longitudes(i);
+
+      stops.push_back({names.get_name(sums.name_offset,
+                                      stops_proto.name_sizes(i)),
+                       {restore_coordinate(sums.latitude),
+                        restore_coordinate(sums.longitude)}});
+    }
 
-    *transport_catalogue_proto.add_distances() = std::move(distance_proto);
+  } else {
+    for (int i = begin; i < end; ++i) {
+      const auto &stop = chunk_proto.stops(i);
+
+      stops.push_back({names.get_name(stop.name_offset(), stop.name_size()),
+                       {stop.latitude(), stop.longitude()}});
+    }
   }
 
-  return transport_catalogue_proto;
+  return stops;
 }
 
-transport_catalogue::TransportCatalogue transport_catalogue_deserialization(
-    const transport_catalogue_protobuf::TransportCatalogue
-        &transport_catalogue_proto) {
+// Decodes the road distances of a chunk whose first stop has the id
+// first_stop_id.
+static std::vector<DecodedDistance>
+decode_distances(const transport_catalogue_protobuf::TransportCatalogue
+                     &chunk_proto,
+                 uint32_t first_stop_id) {
+
+  const bool compact = chunk_proto.has_compact_stops();
+  const auto &distance_stops_proto = chunk_proto.distance_stops();
+  const auto &distances_proto = chunk_proto.distances();
+  const uint32_t stops_count =
+      compact ? chunk_proto.compact_stops().name_sizes_size()
+              : chunk_proto.stops_size();
+
+  std::vector<DecodedDistance> distances;
+  int distance_index = 0;
+
+  distances.reserve(distances_proto.size());
+  for (uint32_t i = 0; i < stops_count; ++i) {
+    const uint32_t distances_count =
+        compact ? chunk_proto.compact_stops().distances_counts(i)
+                : chunk_proto.stops(i).distances_count();
+    uint32_t neighbour = 0;
+
+    for (uint32_t j = 0; j < distances_count; ++j) {
+      neighbour = compact ? neighbour + distance_stops_proto[distance_index]
+                          : distance_stops_proto[distance_index];
+
+      distances.push_back({first_stop_id + i, neighbour,
+                           static_cast<int>(distances_proto[distance_index])});
+      ++distance_index;
+    }
+  }
+
+  return distances;
+}
+
+// Decodes the buses [begin, end) of a chunk, given the sums of the buses
+// before begin.
+static std::vector<DecodedBus>
+decode_buses(const transport_catalogue_protobuf::TransportCatalogue
+                 &chunk_proto,
+             const domain::NameArena &names, int begin, int end,
+             DeltaSums sums) {
+
+  std::vector<DecodedBus> buses;
 
-  transport_catalogue::TransportCatalogue transport_catalogue;
+  buses.reserve(end - begin);
 
-  const auto &stops_proto = transport_catalogue_proto.stops();
-  const auto &buses_proto = transport_catalogue_proto.buses();
-  const auto &distances_proto = transport_catalogue_proto.distances();
+  if (chunk_proto.has_compact_buses()) {
+    const auto &buses_proto = chunk_proto.compact_buses();
 
-  for (const auto &stop : stops_proto) {
+    for (int i = begin; i < end; ++i) {
+      DecodedBus bus;
+      int64_t stop_id = 0;
 
-    domain::Stop tc_stop;
+      sums.name_offset += buses_proto.name_offsets(i);
+      bus.name = names.get_name(sums.name_offset, buses_proto.name_sizes(i));
+      bus.is_roundtrip = buses_proto.is_roundtrip(i);
 
-    tc_stop.name = stop.name();
-    tc_stop.latitude = stop.latitude();
-    tc_stop.longitude = stop.longitude();
+      bus.stops.reserve(buses_proto.stops_counts(i));
+      for (uint32_t j = 0; j < buses_proto.stops_counts(i); ++j) {
+        stop_id += buses_proto.stops(sums.stop_index++);
+        bus.stops.push_back(static_cast<uint32_t>(stop_id));
+      }
 
-    transport_catalogue.add_stop(std::move(tc_stop));
+      buses.push_back(std::move(bus));
+    }
+
+  } else {
+    for (int i = begin; i < end; ++i) {
+      const auto &bus_proto = chunk_proto.buses(i);
+
+      buses.push_back(
+          {names.get_name(bus_proto.name_offset(), bus_proto.name_size()),
+           {bus_proto.stops().begin(), bus_proto.stops().end()},
+           bus_proto.is_roundtrip()});
+    }
   }
 
-  const auto &tc_stops = transport_catalogue.get_stops();
+  return buses;
+}
 
-  std::vector<domain::Distance> distances;
-  for (const auto &distance : distances_proto) {
+void CatalogueLoader::add_names(std::string_view names) {
+  names_.append(names);
+}
+
+void CatalogueLoader::add_indexes(
+    const transport_catalogue_protobuf::TransportCatalogue &indexes_proto) {
 
-    domain::Distance tc_distance;
+  catalogue_.set_names(names_);
+  names_ = {};
 
-    tc_distance.start =
-        transport_catalogue.get_stop(tc_stops[distance.start()].name);
-    tc_distance.end =
-        transport_catalogue.get_stop(tc_stops[distance.end()].name);
+  // The indexes are independent of each other and decoded at once.
+  auto stop_index_future =
+      std::async(std::launch::async, name_index_deserialization,
+                 std::cref(indexes_proto.stop_index()));
+  auto bus_index_future =
+      std::async(std::launch::async, name_index_deserialization,
+                 std::cref(indexes_proto.bus_index()));
+  auto stop_trie_future =
+      std::async(std::launch::async, name_trie_deserialization,
+                 std::cref(indexes_proto.stop_trie()));
 
-    tc_distance.distance = distance.distance();
+  const auto &spatial_index_proto = indexes_proto.spatial_index();
 
-    distances.push_back(tc_distance);
+  if (spatial_index_proto.boxes().empty()) {
+    spatial_ids_.assign(spatial_index_proto.ids().begin(),
+                        spatial_index_proto.ids().end());
+  } else {
+    catalogue_.set_spatial_index(
+        spatial_index_deserialization(spatial_index_proto));
   }
 
-  transport_catalogue.add_distance(distances);
+  // Stored statistics are taken as they are, so the stops and buses are
+  // added without counting them.
+  has_network_stats_ = indexes_proto.has_network_stats();
+  network_stats_proto_ = indexes_proto.network_stats();
+  catalogue_.keep_network_stats(!has_network_stats_);
+
+  catalogue_.set_name_index(stop_index_future.get(), bus_index_future.get());
+  catalogue_.set_name_trie(stop_trie_future.get());
+}
+
+void CatalogueLoader::add_stops(
+    const transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
+
+  compact_ = compact_ || chunk_proto.has_compact_stops();
 
-  for (const auto &bus_proto : buses_proto) {
+  auto distances_future =
+      std::async(std::launch::async, decode_distances, std::cref(chunk_proto),
+                 static_cast<uint32_t>(stops_.size()));
 
-    domain::Bus tc_bus;
+  const int stops_count = chunk_proto.has_compact_stops()
+                              ? chunk_proto.compact_stops().name_sizes_size()
+                              : chunk_proto.stops_size();
+  const int parts_count = get_parts_count();
 
-    tc_bus.name = bus_proto.name();
+  // The parts are decoded at once, each from the sums of the parts before
+  // it, which are summed up here while the earlier parts run.
+  std::vector<std::future<std::vector<DecodedStop>>> stop_futures;
+  DeltaSums sums;
 
-    for (auto stop_id : bus_proto.stops()) {
-      auto name = tc_stops[stop_id].name;
-      tc_bus.stops.push_back(transport_catalogue.get_stop(name));
+  for (int part = 0; part < parts_count; ++part) {
+    const int begin = stops_count * part / parts_count;
+    const int end = stops_count * (part + 1) / parts_count;
+
+    stop_futures.push_back(std::async(
+        std::launch::async, decode_stops, std::cref(chunk_proto),
+        std::cref(catalogue_.get_names()), begin, end, sums));
+
+    if (chunk_proto.has_compact_stops()) {
+      const auto &stops_proto = chunk_proto.compact_stops();
+
+      for (int i = begin; i < end; ++i) {
+        sums.name_offset += stops_proto.name_offsets(i);
+        sums.latitude += stops_proto.latitudes(i);
+        sums.longitude += stops_proto.longitudes(i);
+      }
     }
+  }
 
-    tc_bus.is_roundtrip = bus_proto.is_roundtrip();
-    tc_bus.route_length = bus_proto.route_length();
+  for (auto &stop_future : stop_futures) {
+    for (const auto &stop : stop_future.get()) {
 
-    transport_catalogue.add_bus(std::move(tc_bus));
+      domain::Stop tc_stop;
+
+      tc_stop.name = stop.name;
+      tc_stop.latitude = stop.coordinates.latitude;
+      tc_stop.longitude = stop.coordinates.longitude;
+
+      stops_.push_back(catalogue_.add_stop(std::move(tc_stop)));
+
+      if (!spatial_ids_.empty()) {
+        points_.push_back(stop.coordinates);
+      }
+    }
   }
 
-  return transport_catalogue;
+  const std::vector<DecodedDistance> distances = distances_future.get();
+  distances_.insert(distances_.end(), distances.begin(), distances.end());
+}
+
+void CatalogueLoader::add_buses(
+    const transport_catalogue_protobuf::TransportCatalogue &chunk_proto) {
+
+  finish_stops();
+
+  const int buses_count = chunk_proto.has_compact_buses()
+                              ? chunk_proto.compact_buses().name_sizes_size()
+                              : chunk_proto.buses_size();
+  const int parts_count = get_parts_count();
+
+  // Each part reads only the chunk and the name blob, so all of them are
+  // decoded at once, each from the sums of the parts before it; the
+  // catalogue itself is filled in one thread.
+  std::vector<std::future<std::vector<DecodedBus>>> bus_futures;
+  DeltaSums sums;
+
+  for (int part = 0; part < parts_count; ++part) {
+    const int begin = buses_count * part / parts_count;
+    const int end = buses_count * (part + 1) / parts_count;
+
+    bus_futures.push_back(std::async(
+        std::launch::async, decode_buses, std::cref(chunk_proto),
+        std::cref(catalogue_.get_names()), begin, end, sums));
+
+    if (chunk_proto.has_compact_buses()) {
+      const auto &buses_proto = chunk_proto.compact_buses();
+
+      for (int i = begin; i < end; ++i) {
+        sums.name_offset += buses_proto.name_offsets(i);
+        sums.stop_index += buses_proto.stops_counts(i);
+      }
+    }
+  }
+
+  for (auto &bus_future : bus_futures) {
+    for (const auto &bus : bus_future.get()) {
+
+      domain::Bus tc_bus;
+
+      tc_bus.name = bus.name;
+      tc_bus.is_roundtrip = bus.is_roundtrip;
+
+      tc_bus.stops.reserve(bus.stops.size());
+      for (auto stop_id : bus.stops) {
+        tc_bus.stops.push_back(stops_[stop_id]);
+      }
+
+      catalogue_.add_bus(std::move(tc_bus));
+    }
+  }
+}
+
+void CatalogueLoader::finish_stops() {
+  if (stops_finished_) {
+    return;
+  }
+
+  stops_finished_ = true;
+
+  if (!spatial_ids_.empty()) {
+    domain::SpatialIndex spatial_index;
+
+    spatial_index.restore(std::move(spatial_ids_), points_);
+    catalogue_.set_spatial_index(std::move(spatial_index));
+    points_ = {};
+  }
+
+  std::vector<domain::Distance> distances;
+
+  distances.reserve(distances_.size());
+  for (const auto &distance : distances_) {
+    distances.push_back(
+        {stops_[distance.start], stops_[distance.end], distance.distance});
+  }
+
+  distances_ = {};
+  catalogue_.add_distance(distances);
+}
+
+bool CatalogueLoader::is_compact() const { return compact_; }
+
+transport_catalogue::TransportCatalogue CatalogueLoader::finish() {
+  finish_stops();
+
+  if (has_network_stats_) {
+    catalogue_.set_network_stats(network_stats_deserialization(
+        network_stats_proto_, catalogue_.get_names()));
+    catalogue_.keep_network_stats(true);
+  } else {
+    catalogue_.refresh_network_stats();
+  }
+
+  return std::move(catalogue_);
+}
+
+transport_catalogue::TransportCatalogue transport_catalogue_deserialization(
+    const transport_catalogue_protobuf::TransportCatalogue
+        &transport_catalogue_proto) {
+
+  CatalogueLoader loader;
+
+  loader.add_names(transport_catalogue_proto.names());
+  loader.add_indexes(transport_catalogue_proto);
+  loader.add_stops(transport_catalogue_proto);
+  loader.add_buses(transport_catalogue_proto);
+
+  return loader.finish();
 }
 
 transport_catalogue_protobuf::Color
@@ -296,43 +924,469 @@ domain::RoutingSettings routing_settings_deserialization(
   return routing_settings;
 }
 
+// Writes one record of a chunked base: the tag of its Catalogue field and
+// the length-delimited value.
+static void write_record(google::protobuf::io::CodedOutputStream &output,
+                         int field, std::string_view value) {
+  using google::protobuf::internal::WireFormatLite;
+
+  output.WriteTag(WireFormatLite::MakeTag(
+      field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  output.WriteVarint32(static_cast<uint32_t>(value.size()));
+  output.WriteRaw(value.data(), static_cast<int>(value.size()));
+}
+
+static void write_record(google::protobuf::io::CodedOutputStream &output,
+                         int field, google::protobuf::Message &message) {
+  using google::protobuf::internal::WireFormatLite;
+
+  const size_t size = message.ByteSizeLong();
+
+  output.WriteTag(WireFormatLite::MakeTag(
+      field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  output.WriteVarint32(static_cast<uint32_t>(size));
+  message.SerializeWithCachedSizes(&output);
+  message.Clear();
+}
+
+// Writes an answer table as records of CHUNK_SIZE answers each.
+static void
+answers_serialization(google::protobuf::io::CodedOutputStream &output,
+                      int field, const domain::AnswerTable &answers,
+                      transport_catalogue_protobuf::AnswersChunk &chunk_proto) {
+
+  const auto &offsets = answers.get_offsets();
+  const auto &id_positions = answers.get_id_positions();
+
+  for (size_t begin = 0; begin < id_positions.size(); begin += CHUNK_SIZE) {
+    const size_t end = std::min(begin + CHUNK_SIZE, id_positions.size());
+
+    chunk_proto.set_text(answers.get_text().data() + offsets[begin],
+                         offsets[end] - offsets[begin]);
+
+    for (size_t id = begin; id < end; ++id) {
+      chunk_proto.add_sizes(
+          static_cast<uint32_t>(offsets[id + 1] - offsets[id]));
+      chunk_proto.add_id_positions(id_positions[id]);
+    }
+
+    write_record(output, field, chunk_proto);
+  }
+}
+
 void catalogue_serialization(
     const transport_catalogue::TransportCatalogue &transport_catalogue,
     const map_renderer::RenderSettings &render_settings,
-    const domain::RoutingSettings &routing_settings, std::ostream &out) {
+    const domain::RoutingSettings &routing_settings,
+    const Precomputed &precomputed, bool compact, std::ostream &out) {
+
+  using CatalogueProto = transport_catalogue_protobuf::Catalogue;
+
+  const auto &stops = transport_catalogue.get_stops();
+  const auto &buses = transport_catalogue.get_buses();
+  const auto &names = transport_catalogue.get_names();
+
+  google::protobuf::io::OstreamOutputStream raw_output(&out);
+  google::protobuf::io::CodedOutputStream output(&raw_output);
 
-  transport_catalogue_protobuf::Catalogue catalogue_proto;
+  // A chunk message is cleared after each record and filled again, so its
+  // nested messages are allocated once for the whole base.
+  transport_catalogue_protobuf::TransportCatalogue chunk_proto;
 
-  transport_catalogue_protobuf::TransportCatalogue transport_catalogue_proto =
-      transport_catalogue_serialization(transport_catalogue);
-  transport_catalogue_protobuf::RenderSettings render_settings_proto =
-      render_settings_serialization(render_settings);
-  transport_catalogue_protobuf::RoutingSettings routing_settings_proto =
+  const std::string blob = names.get_blob();
+
+  for (size_t pos = 0; pos < blob.size(); pos += PIECE_SIZE) {
+    write_record(output, CatalogueProto::kNamesChunksFieldNumber,
+                 std::string_view(blob).substr(pos, PIECE_SIZE));
+  }
+
+  *chunk_proto.mutable_stop_index() =
+      name_index_serialization(transport_catalogue.get_stop_index());
+  *chunk_proto.mutable_bus_index() =
+      name_index_serialization(transport_catalogue.get_bus_index());
+  *chunk_proto.mutable_stop_trie() =
+      name_trie_serialization(transport_catalogue.get_stop_trie());
+  *chunk_proto.mutable_spatial_index() =
+      spatial_index_serialization(transport_catalogue.get_spatial_index());
+  *chunk_proto.mutable_network_stats() =
+      network_stats_serialization(transport_catalogue.get_network_stats(),
+                                  names);
+
+  // A compact base keeps only the leaf order of the spatial index.
+  if (compact) {
+    chunk_proto.mutable_spatial_index()->clear_boxes();
+  }
+
+  write_record(output, CatalogueProto::kIndexesChunkFieldNumber, chunk_proto);
+
+  StopIds stop_ids;
+
+  stop_ids.reserve(stops.size());
+  for (const auto &stop : stops) {
+    stop_ids.emplace(&stop, static_cast<uint32_t>(stop_ids.size()));
+  }
+
+  // At least one chunk of stops is written, which tells a reader whether
+  // the base is compact even if it has no stops.
+  size_t begin = 0;
+
+  do {
+    const size_t end = std::min(begin + CHUNK_SIZE, stops.size());
+
+    if (compact) {
+      compact_stops_serialization(stops, begin, end, names, stop_ids,
+                                  chunk_proto);
+    } else {
+      stops_serialization(stops, begin, end, names, stop_ids, chunk_proto);
+    }
+
+    write_record(output, CatalogueProto::kStopsChunksFieldNumber, chunk_proto);
+    begin = end;
+  } while (begin < stops.size());
+
+  for (begin = 0; begin < buses.size(); begin += CHUNK_SIZE) {
+    const size_t end = std::min(begin + CHUNK_SIZE, buses.size());
+
+    if (compact) {
+      compact_buses_serialization(buses, begin, end, names, stop_ids,
+                                  chunk_proto);
+    } else {
+      buses_serialization(buses, begin, end, names, stop_ids, chunk_proto);
+    }
+
+    write_record(output, CatalogueProto::kBusesChunksFieldNumber, chunk_proto);
+  }
+
+  auto render_settings_proto = render_settings_serialization(render_settings);
+  auto routing_settings_proto =
       routing_settings_serialization(routing_settings);
 
-  *catalogue_proto.mutable_transport_catalogue() =
-      std::move(transport_catalogue_proto);
-  *catalogue_proto.mutable_render_settings() = std::move(render_settings_proto);
-  *catalogue_proto.mutable_routing_settings() =
-      std::move(routing_settings_proto);
+  write_record(output, CatalogueProto::kRenderSettingsFieldNumber,
+               render_settings_proto);
+  write_record(output, CatalogueProto::kRoutingSettingsFieldNumber,
+               routing_settings_proto);
 
-  catalogue_proto.SerializePartialToOstream(&out);
+  const std::string_view map = precomputed.map;
+
+  for (size_t pos = 0; pos < map.size(); pos += PIECE_SIZE) {
+    write_record(output, CatalogueProto::kMapChunksFieldNumber,
+                 map.substr(pos, PIECE_SIZE));
+  }
+
+  transport_catalogue_protobuf::AnswersChunk answers_proto;
+
+  answers_serialization(output, CatalogueProto::kStopAnswersChunksFieldNumber,
+                        precomputed.stop_answers, answers_proto);
+  answers_serialization(output, CatalogueProto::kBusAnswersChunksFieldNumber,
+                        precomputed.bus_answers, answers_proto);
 }
 
-Catalogue catalogue_deserialization(std::istream &in) {
+namespace {
+
+// Joins the chunks of an answer table back into one table.
+class AnswersLoader {
+public:
+  void add(const transport_catalogue_protobuf::AnswersChunk &chunk_proto);
+  domain::AnswerTable finish();
 
-  transport_catalogue_protobuf::Catalogue catalogue_proto;
-  auto success_parsing_catalogue_from_istream =
-      catalogue_proto.ParseFromIstream(&in);
+private:
+  std::vector<char> text_;
+  std::vector<uint64_t> offsets_{0};
+  std::vector<uint32_t> id_positions_;
+};
 
-  if (!success_parsing_catalogue_from_istream) {
+void AnswersLoader::add(
+    const transport_catalogue_protobuf::AnswersChunk &chunk_proto) {
+
+  text_.insert(text_.end(), chunk_proto.text().begin(),
+               chunk_proto.text().end());
+
+  for (uint32_t size : chunk_proto.sizes()) {
+    offsets_.push_back(offsets_.back() + size);
+  }
+
+  id_positions_.insert(id_positions_.end(), chunk_proto.id_positions().begin(),
+                       chunk_proto.id_positions().end());
+
+  if (offsets_.back() != text_.size() ||
+      offsets_.size() != id_positions_.size() + 1) {
     throw std::runtime_error("cannot parse serialized file from istream");
   }
+}
+
+domain::AnswerTable AnswersLoader::finish() {
+  if (id_positions_.empty()) {
+    return {};
+  }
+
+  return {std::move(text_), std::move(offsets_), std::move(id_positions_)};
+}
+
+} // end namespace
+
+// Reads a base record by record. The records are the fields of a Catalogue
+// message, tagged and length-prefixed, which makes them a section table:
+// the wanted ones are parsed and the others skipped without decoding.
+static Catalogue
+catalogue_sections_deserialization(std::istream &in, BaseSections sections) {
+
+  using google::protobuf::internal::WireFormatLite;
+  using CatalogueProto = transport_catalogue_protobuf::Catalogue;
+
+  google::protobuf::io::IstreamInputStream raw_input(&in);
+  google::protobuf::Arena arena;
+  auto *catalogue_proto =
+      google::protobuf::Arena::CreateMessage<CatalogueProto>(&arena);
+  auto *chunk_proto = google::protobuf::Arena::CreateMessage<
+      transport_catalogue_protobuf::TransportCatalogue>(&arena);
+  auto *answers_proto = google::protobuf::Arena::CreateMessage<
+      transport_catalogue_protobuf::AnswersChunk>(&arena);
+
+  CatalogueLoader loader;
+  AnswersLoader stop_answers;
+  AnswersLoader bus_answers;
+  std::string piece;
+  std::string map;
+
+  while (true) {
+    // A coded stream counts the bytes it reads against a limit of 2 GB, so
+    // each record gets a stream of its own.
+    google::protobuf::io::CodedInputStream input(&raw_input);
+    const uint32_t tag = input.ReadTag();
+
+    if (tag == 0) {
+      break;
+    }
+
+    const int field = WireFormatLite::GetTagFieldNumber(tag);
+    google::protobuf::Message *record = nullptr;
+    std::string *bytes_record = nullptr;
+
+    switch (field) {
+    case CatalogueProto::kTransportCatalogueFieldNumber:
+      record = catalogue_proto->mutable_transport_catalogue();
+      break;
+    case CatalogueProto::kIndexesChunkFieldNumber:
+    case CatalogueProto::kStopsChunksFieldNumber:
+    case CatalogueProto::kBusesChunksFieldNumber:
+      chunk_proto->Clear();
+      record = chunk_proto;
+      break;
+    case CatalogueProto::kNamesChunksFieldNumber:
+      bytes_record = &piece;
+      break;
+    case CatalogueProto::kRenderSettingsFieldNumber:
+      if (sections.render_settings) {
+        record = catalogue_proto->mutable_render_settings();
+      }
+      break;
+    case CatalogueProto::kRoutingSettingsFieldNumber:
+      if (sections.routing_settings) {
+        record = catalogue_proto->mutable_routing_settings();
+      }
+      break;
+    case CatalogueProto::kMapFieldNumber:
+    case CatalogueProto::kMapChunksFieldNumber:
+      if (sections.map) {
+        bytes_record = &piece;
+      }
+      break;
+    case CatalogueProto::kStopAnswersChunksFieldNumber:
+    case CatalogueProto::kBusAnswersChunksFieldNumber:
+      if (sections.answers) {
+        answers_proto->Clear();
+        record = answers_proto;
+      }
+      break;
+    }
+
+    if (!record && !bytes_record) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        throw std::runtime_error("cannot parse serialized file from istream");
+      }
+      continue;
+    }
+
+    if (WireFormatLite::GetTagWireType(tag) !=
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      throw std::runtime_error("cannot parse serialized file from istream");
+    }
+
+    if (bytes_record) {
+      if (!WireFormatLite::ReadBytes(&input, bytes_record)) {
+        throw std::runtime_error("cannot parse serialized file from istream");
+      }
+    } else {
+      uint32_t size = 0;
+
+      if (!input.ReadVarint32(&size)) {
+        throw std::runtime_error("cannot parse serialized file from istream");
+      }
+
+      const auto limit = input.PushLimit(static_cast<int>(size));
+
+      if (!record->MergePartialFromCodedStream(&input) ||
+          !input.ConsumedEntireMessage()) {
+        throw std::runtime_error("cannot parse serialized file from istream");
+      }
+
+      input.PopLimit(limit);
+    }
+
+    switch (field) {
+    case CatalogueProto::kTransportCatalogueFieldNumber: {
+      const auto &transport_catalogue_proto =
+          catalogue_proto->transport_catalogue();
+
+      loader.add_names(transport_catalogue_proto.names());
+      loader.add_indexes(transport_catalogue_proto);
+      loader.add_stops(transport_catalogue_proto);
+      loader.add_buses(transport_catalogue_proto);
+      catalogue_proto->clear_transport_catalogue();
+      break;
+    }
+    case CatalogueProto::kNamesChunksFieldNumber:
+      loader.add_names(piece);
+      break;
+    case CatalogueProto::kIndexesChunkFieldNumber:
+      loader.add_indexes(*chunk_proto);
+      break;
+    case CatalogueProto::kStopsChunksFieldNumber:
+      loader.add_stops(*chunk_proto);
+      break;
+    case CatalogueProto::kBusesChunksFieldNumber:
+      loader.add_buses(*chunk_proto);
+      break;
+    case CatalogueProto::kMapFieldNumber:
+    case CatalogueProto::kMapChunksFieldNumber:
+      map += piece;
+      break;
+    case CatalogueProto::kStopAnswersChunksFieldNumber:
+      stop_answers.add(*answers_proto);
+      break;
+    case CatalogueProto::kBusAnswersChunksFieldNumber:
+      bus_answers.add(*answers_proto);
+      break;
+    }
+  }
+
+  const bool compact = loader.is_compact();
+
+  return {loader.finish(),
+          render_settings_deserialization(catalogue_proto->render_settings()),
+          routing_settings_deserialization(catalogue_proto->routing_settings()),
+          compact,
+          {std::move(map), stop_answers.finish(), bus_answers.finish()}};
+}
+
+Catalogue catalogue_deserialization(std::istream &in) {
+  return catalogue_sections_deserialization(in, {});
+}
+
+void flat_catalogue_serialization(
+    const transport_catalogue::FrozenCatalogue &frozen_catalogue,
+    const map_renderer::RenderSettings &render_settings,
+    const domain::RoutingSettings &routing_settings,
+    const Precomputed &precomputed, std::ostream &out) {
+
+  // The settings are small and not used in place, so they keep their
+  // protobuf encoding inside their sections.
+  const std::string render_settings_data =
+      render_settings_serialization(render_settings).SerializeAsString();
+  const std::string routing_settings_data =
+      routing_settings_serialization(routing_settings).SerializeAsString();
+  domain::FlatWriter writer;
+
+  writer.add(domain::FlatSection::RENDER_SETTINGS, render_settings_data.data(),
+             render_settings_data.size());
+  writer.add(domain::FlatSection::ROUTING_SETTINGS,
+             routing_settings_data.data(), routing_settings_data.size());
+  writer.add(domain::FlatSection::MAP, precomputed.map.data(),
+             precomputed.map.size());
+
+  if (!precomputed.stop_answers.empty()) {
+    writer.add(domain::FlatSection::STOP_ANSWERS,
+               precomputed.stop_answers.get_text());
+    writer.add(domain::FlatSection::STOP_ANSWER_OFFSETS,
+               precomputed.stop_answers.get_offsets());
+    writer.add(domain::FlatSection::STOP_ANSWER_ID_POSITIONS,
+               precomputed.stop_answers.get_id_positions());
+  }
+
+  if (!precomputed.bus_answers.empty()) {
+    writer.add(domain::FlatSection::BUS_ANSWERS,
+               precomputed.bus_answers.get_text());
+    writer.add(domain::FlatSection::BUS_ANSWER_OFFSETS,
+               precomputed.bus_answers.get_offsets());
+    writer.add(domain::FlatSection::BUS_ANSWER_ID_POSITIONS,
+               precomputed.bus_answers.get_id_positions());
+  }
+
+  frozen_catalogue.save(writer);
+  writer.write(out);
+}
+
+FrozenBase load_frozen_base(const std::string &file_name,
+                            domain::FlatReader &flat_base,
+                            BaseSections sections) {
+
+  if (!flat_base.open(file_name)) {
+    std::ifstream in_file(file_name, std::ios::binary);
+    Catalogue catalogue = catalogue_sections_deserialization(in_file, sections);
+
+    return {catalogue.transport_catalogue_.freeze(),
+            std::move(catalogue.render_settings_),
+            std::move(catalogue.routing_settings_),
+            std::move(catalogue.precomputed_)};
+  }
+
+  FrozenBase base{transport_catalogue::FrozenCatalogue(flat_base), {}, {}, {}};
+
+  if (sections.render_settings) {
+    const auto data = flat_base.get<char>(domain::FlatSection::RENDER_SETTINGS);
+    transport_catalogue_protobuf::RenderSettings render_settings_proto;
+
+    if (!render_settings_proto.ParseFromArray(data.data(),
+                                              static_cast<int>(data.size()))) {
+      throw std::runtime_error("cannot parse render settings of the flat base");
+    }
+
+    base.render_settings_ =
+        render_settings_deserialization(render_settings_proto);
+  }
+
+  if (sections.routing_settings) {
+    const auto data =
+        flat_base.get<char>(domain::FlatSection::ROUTING_SETTINGS);
+    transport_catalogue_protobuf::RoutingSettings routing_settings_proto;
+
+    if (!routing_settings_proto.ParseFromArray(data.data(),
+                                               static_cast<int>(data.size()))) {
+      throw std::runtime_error(
+          "cannot parse routing settings of the flat base");
+    }
+
+    base.routing_settings_ =
+        routing_settings_deserialization(routing_settings_proto);
+  }
+
+  if (sections.map) {
+    const auto map = flat_base.get<char>(domain::FlatSection::MAP);
+    base.precomputed_.map.assign(map.data(), map.size());
+  }
+
+  if (sections.answers) {
+    base.precomputed_.stop_answers = domain::AnswerTable(
+        flat_base.get<char>(domain::FlatSection::STOP_ANSWERS),
+        flat_base.get<uint64_t>(domain::FlatSection::STOP_ANSWER_OFFSETS),
+        flat_base.get<uint32_t>(domain::FlatSection::STOP_ANSWER_ID_POSITIONS));
+    base.precomputed_.bus_answers = domain::AnswerTable(
+        flat_base.get<char>(domain::FlatSection::BUS_ANSWERS),
+        flat_base.get<uint64_t>(domain::FlatSection::BUS_ANSWER_OFFSETS),
+        flat_base.get<uint32_t>(domain::FlatSection::BUS_ANSWER_ID_POSITIONS));
+  }
 
-  return {transport_catalogue_deserialization(
-              catalogue_proto.transport_catalogue()),
-          render_settings_deserialization(catalogue_proto.render_settings()),
-          routing_settings_deserialization(catalogue_proto.routing_settings())};
+  return base;
 }
 
 } // end namespace serialization
\ No newline at end of file
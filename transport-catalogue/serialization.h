@@ -1,5 +1,6 @@
 #pragma once
 
+#include "answer_table.h"
 #include "transport_catalogue.h"
 #include "transport_catalogue.pb.h"
 
@@ -12,25 +13,86 @@
 #include "transport_router.pb.h"
 
 #include <iostream>
+#include <string>
+#include <string_view>
 
 namespace serialization {
 
+// A protobuf base can be loaded back into a TransportCatalogue and changed
+// by apply_delta; a compact one is the same with quantized coordinates and
+// delta-coded columns, several times smaller. A flat base is mapped by
+// process_requests and used in place, but is read-only.
+enum class Format { PROTOBUF, COMPACT, FLAT };
+
 struct SerializationSettings {
   std::string file_name;
+  Format format = Format::PROTOBUF;
+  // Store the answers to Stop and Bus requests in the base.
+  bool precompute_answers = false;
+  // File of the route table, written by make_base and apply_delta and
+  // mapped by process_requests; no table is used if empty.
+  std::string route_table_file;
+};
+
+// Results computed when a base is written so that process_requests does not
+// compute them again. Each part is empty if it was not precomputed.
+struct Precomputed {
+  // SVG of the whole map.
+  std::string map;
+  domain::AnswerTable stop_answers;
+  domain::AnswerTable bus_answers;
 };
 
 struct Catalogue {
   transport_catalogue::TransportCatalogue transport_catalogue_;
   map_renderer::RenderSettings render_settings_;
   domain::RoutingSettings routing_settings_;
+  // The base was written in the compact format; apply_delta keeps it.
+  bool compact_ = false;
+  Precomputed precomputed_;
+};
+
+// Parts of a base besides the catalogue. A base is read section by
+// section, and those not asked for are skipped and left default.
+struct BaseSections {
+  bool render_settings = true;
+  bool routing_settings = true;
+  bool map = true;
+  bool answers = true;
 };
 
-template <typename It>
-uint32_t calculate_id(It start, It end, std::string_view name);
+struct FrozenBase {
+  transport_catalogue::FrozenCatalogue catalogue_;
+  map_renderer::RenderSettings render_settings_;
+  domain::RoutingSettings routing_settings_;
+  // Parts not stored in the base or not asked for are left empty.
+  Precomputed precomputed_;
+};
 
-transport_catalogue_protobuf::TransportCatalogue
-transport_catalogue_serialization(
-    const transport_catalogue::TransportCatalogue &transport_catalogue);
+transport_catalogue_protobuf::NameIndex
+name_index_serialization(const domain::NameIndex &name_index);
+domain::NameIndex name_index_deserialization(
+    const transport_catalogue_protobuf::NameIndex &name_index_proto);
+
+transport_catalogue_protobuf::NameTrie
+name_trie_serialization(const domain::NameTrie &name_trie);
+domain::NameTrie name_trie_deserialization(
+    const transport_catalogue_protobuf::NameTrie &name_trie_proto);
+
+transport_catalogue_protobuf::NetworkStats
+network_stats_serialization(const domain::NetworkStats &network_stats,
+                            const domain::NameArena &names);
+domain::NetworkStats network_stats_deserialization(
+    const transport_catalogue_protobuf::NetworkStats &network_stats_proto,
+    const domain::NameArena &names);
+
+transport_catalogue_protobuf::SpatialIndex
+spatial_index_serialization(const domain::SpatialIndex &spatial_index);
+domain::SpatialIndex spatial_index_deserialization(
+    const transport_catalogue_protobuf::SpatialIndex &spatial_index_proto);
+
+// Loads a catalogue stored as one message, the layout of bases written
+// before they were split into chunks.
 transport_catalogue::TransportCatalogue transport_catalogue_deserialization(
     const transport_catalogue_protobuf::TransportCatalogue
         &transport_catalogue_proto);
@@ -53,8 +115,21 @@ domain::RoutingSettings routing_settings_deserialization(
 void catalogue_serialization(
     const transport_catalogue::TransportCatalogue &transport_catalogue,
     const map_renderer::RenderSettings &render_settings,
-    const domain::RoutingSettings &routing_settings, std::ostream &out);
+    const domain::RoutingSettings &routing_settings,
+    const Precomputed &precomputed, bool compact, std::ostream &out);
 
 Catalogue catalogue_deserialization(std::istream &in);
 
+void flat_catalogue_serialization(
+    const transport_catalogue::FrozenCatalogue &frozen_catalogue,
+    const map_renderer::RenderSettings &render_settings,
+    const domain::RoutingSettings &routing_settings,
+    const Precomputed &precomputed, std::ostream &out);
+
+// Opens a base of any format for reading. A flat base is mapped through
+// flat_base, which must outlive the result.
+FrozenBase load_frozen_base(const std::string &file_name,
+                            domain::FlatReader &flat_base,
+                            BaseSections sections);
+
 } // end namespace serialization
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+namespace domain {
+
+static const uint32_t HILBERT_SIZE = 1u << 16;
+
+SpatialIndex::SpatialIndex(FlatArray<uint32_t> ids,
+                           FlatArray<geo::BoundingBox> boxes)
+    : ids_(std::move(ids)), boxes_(std::move(boxes)) {
+  init_levels();
+}
+
+void SpatialIndex::init_levels() {
+  level_bounds_.clear();
+
+  if (ids_.empty()) {
+    return;
+  }
+
+  size_t count = ids_.size();
+  level_bounds_.push_back(count);
+
+  while (count > 1) {
+    count = (count + NODE_SIZE - 1) / NODE_SIZE;
+    level_bounds_.push_back(level_bounds_.back() + count);
+  }
+}
+
+uint32_t SpatialIndex::get_hilbert_value(uint32_t x, uint32_t y) {
+  uint64_t value = 0;
+
+  for (uint32_t side = HILBERT_SIZE / 2; side > 0; side /= 2) {
+    uint32_t rx = (x & side) > 0;
+    uint32_t ry = (y & side) > 0;
+    value += static_cast<uint64_t>(side) * side * ((3 * rx) ^ ry);
+
+    if (ry == 0) {
+      if (rx == 1) {
+        x = HILBERT_SIZE - 1 - x;
+        y = HILBERT_SIZE - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+
+  return static_cast<uint32_t>(value);
+}
+
+void SpatialIndex::build(const std::vector<geo::Coordinates> &points) {
+  ids_ = {};
+  boxes_ = {};
+
+  if (points.empty()) {
+    init_levels();
+    return;
+  }
+
+  geo::BoundingBox extent{points[0].latitude, points[0].longitude,
+                          points[0].latitude, points[0].longitude};
+
+  for (const auto &point : points) {
+    extent.min_latitude = std::min(extent.min_latitude, point.latitude);
+    extent.min_longitude = std::min(extent.min_longitude, point.longitude);
+    extent.max_latitude = std::max(extent.max_latitude, point.latitude);
+    extent.max_longitude = std::max(extent.max_longitude, point.longitude);
+  }
+
+  const double height = extent.max_latitude - extent.min_latitude;
+  const double width = extent.max_longitude - extent.min_longitude;
+
+  std::vector<uint32_t> hilbert_values(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto to_grid = [](double value, double min, double size) {
+      return size > 0 ? static_cast<uint32_t>((value - min) / size *
+                                              (HILBERT_SIZE - 1))
+                      : 0u;
+    };
+
+    hilbert_values[i] = get_hilbert_value(
+        to_grid(points[i].longitude, extent.min_longitude, width),
+        to_grid(points[i].latitude, extent.min_latitude, height));
+  }
+
+  std::vector<uint32_t> ids(points.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&hilbert_values](uint32_t lhs, uint32_t rhs) {
+                     return hilbert_values[lhs] < hilbert_values[rhs];
+                   });
+
+  restore(std::move(ids), points);
+}
+
+void SpatialIndex::restore(FlatArray<uint32_t> ids,
+                           const std::vector<geo::Coordinates> &points) {
+  std::vector<geo::BoundingBox> boxes;
+
+  boxes.reserve(ids.size());
+  for (uint32_t id : ids) {
+    boxes.push_back({points[id].latitude, points[id].longitude,
+                     points[id].latitude, points[id].longitude});
+  }
+
+  ids_ = std::move(ids);
+  init_levels();
+
+  for (size_t level = 1; level < level_bounds_.size(); ++level) {
+    const size_t children_begin = level > 1 ? level_bounds_[level - 2] : 0;
+    const size_t children_end = level_bounds_[level - 1];
+
+    for (size_t i = children_begin; i < children_end; i += NODE_SIZE) {
+      geo::BoundingBox node = boxes[i];
+
+      for (size_t j = i + 1; j < std::min(i + NODE_SIZE, children_end); ++j) {
+        node.min_latitude = std::min(node.min_latitude, boxes[j].min_latitude);
+        node.min_longitude =
+            std::min(node.min_longitude, boxes[j].min_longitude);
+        node.max_latitude = std::max(node.max_latitude, boxes[j].max_latitude);
+        node.max_longitude =
+            std::max(node.max_longitude, boxes[j].max_longitude);
+      }
+
+      boxes.push_back(node);
+    }
+  }
+
+  boxes_ = std::move(boxes);
+}
+
+// Distance from the point to the nearest point of the box on the sphere,
+// so that it never exceeds the distance to a stop inside the box.
+double SpatialIndex::get_min_distance(geo::Coordinates point,
+                                      const geo::BoundingBox &box) {
+  if (box.min_latitude == box.max_latitude &&
+      box.min_longitude == box.max_longitude) {
+    return geo::compute_distance(point,
+                                 {box.min_latitude, box.min_longitude});
+  }
+
+  const double dr = geo::PI / 180.;
+  const auto is_within_longitudes = [&box](double longitude) {
+    return box.min_longitude <= longitude && longitude <= box.max_longitude;
+  };
+
+  // Within the longitudes of the box the nearest point is on the same
+  // meridian, and no point is closer than the difference in latitude.
+  if (is_within_longitudes(point.longitude) ||
+      is_within_longitudes(point.longitude - 360.) ||
+      is_within_longitudes(point.longitude + 360.)) {
+    const double latitude =
+        std::clamp(point.latitude, box.min_latitude, box.max_latitude);
+
+    return std::abs(point.latitude - latitude) * dr * geo::EARTH_RADIUS;
+  }
+
+  // Otherwise it is on one of the meridian edges: at the foot of the
+  // perpendicular to the edge's great circle if that falls on the edge,
+  // else at an end of the edge. The trigonometry wraps the longitudes
+  // across the antimeridian.
+  const double latitude = point.latitude * dr;
+  double distance = std::numeric_limits<double>::infinity();
+
+  for (double edge_longitude : {box.min_longitude, box.max_longitude}) {
+    const double delta = (point.longitude - edge_longitude) * dr;
+    const double foot_latitude =
+        std::atan2(std::sin(latitude), std::cos(latitude) * std::cos(delta));
+
+    if (std::cos(delta) > 0. && box.min_latitude * dr <= foot_latitude &&
+        foot_latitude <= box.max_latitude * dr) {
+      const double sin_angle =
+          std::min(std::abs(std::cos(latitude) * std::sin(delta)), 1.);
+      distance =
+          std::min(distance, std::asin(sin_angle) * geo::EARTH_RADIUS);
+
+    } else {
+      distance = std::min(
+          {distance,
+           geo::compute_distance(point, {box.min_latitude, edge_longitude}),
+           geo::compute_distance(point, {box.max_latitude, edge_longitude})});
+    }
+  }
+
+  return distance;
+}
+
+std::vector<uint32_t>
+SpatialIndex::find_in_area(const geo::BoundingBox &area) const {
+  std::vector<uint32_t> result;
+
+  if (ids_.empty()) {
+    return result;
+  }
+
+  std::vector<std::pair<size_t, size_t>> nodes{
+      {boxes_.size() - 1, level_bounds_.size() - 1}};
+
+  while (!nodes.empty()) {
+    auto [node, level] = nodes.back();
+    nodes.pop_back();
+
+    if (!area.intersects(boxes_[node])) {
+      continue;
+    }
+
+    if (level == 0) {
+      result.push_back(ids_[node]);
+      continue;
+    }
+
+    const size_t level_begin = level > 1 ? level_bounds_[level - 2] : 0;
+    const size_t first = level_begin + (node - level_bounds_[level - 1]) *
+                                           NODE_SIZE;
+    const size_t last = std::min(first + NODE_SIZE, level_bounds_[level - 1]);
+
+    for (size_t child = first; child < last; ++child) {
+      nodes.emplace_back(child, level - 1);
+    }
+  }
+
+  return result;
+}
+
+std::vector<std::pair<uint32_t, double>>
+SpatialIndex::find_nearest(geo::Coordinates point, size_t count) const {
+  std::vector<std::pair<uint32_t, double>> result;
+
+  if (ids_.empty() || count == 0) {
+    return result;
+  }
+
+  using QueueItem = std::tuple<double, size_t, size_t>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>>
+      queue;
+
+  queue.emplace(0., boxes_.size() - 1, level_bounds_.size() - 1);
+
+  while (!queue.empty() && result.size() < count) {
+    auto [distance, node, level] = queue.top();
+    queue.pop();
+
+    if (level == 0) {
+      result.emplace_back(ids_[node], distance);
+      continue;
+    }
+
+    const size_t level_begin = level > 1 ? level_bounds_[level - 2] : 0;
+    const size_t first = level_begin + (node - level_bounds_[level - 1]) *
+                                           NODE_SIZE;
+    const size_t last = std::min(first + NODE_SIZE, level_bounds_[level - 1]);
+
+    for (size_t child = first; child < last; ++child) {
+      queue.emplace(get_min_distance(point, boxes_[child]), child, level - 1);
+    }
+  }
+
+  return result;
+}
+
+bool SpatialIndex::empty() const { return ids_.empty(); }
+
+const FlatArray<uint32_t> &SpatialIndex::get_ids() const { return ids_; }
+
+const FlatArray<geo::BoundingBox> &SpatialIndex::get_boxes() const {
+  return boxes_;
+}
+
+} // end namespace domain
\ No newline at end of file
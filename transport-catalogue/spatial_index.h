@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "flat_array.h"
+#include "geo.h"
+
+namespace domain {
+
+// Static packed Hilbert R-tree over stop coordinates. Points are sorted along
+// a Hilbert curve and packed into nodes of NODE_SIZE entries; the bounding
+// boxes of all levels are kept in one array (leaves first, root last), so the
+// tree has no pointers and can be stored in the base as is.
+class SpatialIndex {
+public:
+  static const size_t NODE_SIZE = 16;
+
+  SpatialIndex() = default;
+  SpatialIndex(FlatArray<uint32_t> ids, FlatArray<geo::BoundingBox> boxes);
+
+  void build(const std::vector<geo::Coordinates> &points);
+  // Recomputes the boxes of a tree from its leaf order, which is all a
+  // compact base keeps of the index.
+  void restore(FlatArray<uint32_t> ids,
+               const std::vector<geo::Coordinates> &points);
+
+  std::vector<uint32_t> find_in_area(const geo::BoundingBox &area) const;
+  std::vector<std::pair<uint32_t, double>>
+  find_nearest(geo::Coordinates point, size_t count) const;
+
+  bool empty() const;
+
+  const FlatArray<uint32_t> &get_ids() const;
+  const FlatArray<geo::BoundingBox> &get_boxes() const;
+
+private:
+  static uint32_t get_hilbert_value(uint32_t x, uint32_t y);
+  static double get_min_distance(geo::Coordinates point,
+                                 const geo::BoundingBox &box);
+
+  void init_levels();
+
+  FlatArray<uint32_t> ids_;
+  FlatArray<geo::BoundingBox> boxes_;
+  std::vector<size_t> level_bounds_;
+};
+
+} // end namespace domain
\ No newline at end of file
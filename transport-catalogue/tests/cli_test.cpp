@@ -0,0 +1,419 @@
+#include "json.h"
+#include "test_framework.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Runs the transport_catalogue binary on JSON inputs, the way it is used,
+// and checks its answers. Takes the binary and a scratch directory.
+namespace {
+
+namespace json = transport_catalogue::detail::json;
+
+std::string binary;
+std::filesystem::path directory;
+
+std::string read_file(const std::filesystem::path &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+void write_file(const std::filesystem::path &path, const std::string &text) {
+  std::ofstream out(path, std::ios::binary);
+  out << text;
+}
+
+std::string file(const std::string &name) {
+  return (directory / name).string();
+}
+
+// Runs one mode with the input on stdin; returns the exit code and stores
+// stdout in output.
+int run(const std::string &mode, const std::string &input,
+        std::string *output = nullptr, const std::string &arguments = "") {
+  write_file(directory / "input.json", input);
+
+  const std::string command = "\"" + binary + "\" " + mode + " " + arguments +
+                              " < \"" + file("input.json") + "\" > \"" +
+                              file("output.json") + "\" 2> \"" +
+                              file("errors.txt") + "\"";
+  const int status = std::system(command.c_str());
+
+  if (output) {
+    *output = read_file(directory / "output.json");
+  }
+
+  return status;
+}
+
+const std::string RENDER_SETTINGS = R"("render_settings": {
+  "width": 1200, "height": 500, "padding": 50, "stop_radius": 5,
+  "line_width": 14, "bus_label_font_size": 20, "bus_label_offset": [7, 15],
+  "stop_label_font_size": 18, "stop_label_offset": [7, -3],
+  "underlayer_color": [255, 255, 255, 0.85], "underlayer_width": 3,
+  "color_palette": ["green", [255, 160, 0], "red"]})";
+
+const std::string ROUTING_SETTINGS =
+    R"("routing_settings": {"bus_wait_time": 6, "bus_velocity": 40})";
+
+std::string serialization_settings(const std::string &extra = "") {
+  return R"("serialization_settings": {"file": ")" + file("base.db") +
+         "\"" + extra + "}";
+}
+
+std::string make_base_input(const std::string &base_requests,
+                            const std::string &settings = "") {
+  return "{" + serialization_settings(settings) + ", " + RENDER_SETTINGS +
+         ", " + ROUTING_SETTINGS + R"(, "base_requests": [)" + base_requests +
+         "]}";
+}
+
+std::string process_input(const std::string &stat_requests,
+                           const std::string &settings = "") {
+  return "{" + serialization_settings(settings) + R"(, "stat_requests": [)" +
+         stat_requests + "]}";
+}
+
+json::Document parse(const std::string &text) {
+  std::istringstream in(text);
+  return json::load(in);
+}
+
+} // end namespace
+
+void test_duplicate_names() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.6, "longitude": 37.6,
+     "road_distances": {"B": 1000}},
+    {"type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.61,
+     "road_distances": {}},
+    {"type": "Stop", "name": "A", "latitude": 55.7, "longitude": 37.7,
+     "road_distances": {}},
+    {"type": "Bus", "name": "1", "stops": ["A", "B"], "is_roundtrip": false},
+    {"type": "Bus", "name": "1", "stops": ["B", "A", "B"],
+     "is_roundtrip": true})";
+
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+
+  std::string output;
+  CHECK_EQUAL(run("process_requests",
+                  process_input(R"({"id": 1, "type": "Bus", "name": "1"})"),
+                  &output),
+              0);
+
+  // The first bus of a name answers, as it did before the name index.
+  const auto answer = parse(output).get_root().as_array().at(0).as_dict();
+  CHECK_EQUAL(answer.at("stop_count").as_int(), 3);
+  CHECK_EQUAL(answer.at("route_length").as_int(), 2000);
+}
+
+void test_gtfs_import() {
+  const std::filesystem::path feed = directory / "feed";
+  std::filesystem::create_directories(feed);
+
+  write_file(feed / "stops.txt", "stop_id,stop_name,stop_lat,stop_lon\n"
+                                 "S1,North,55.60,37.60\n"
+                                 "S2,South,55.61,37.61\n"
+                                 "S3,East,55.62,37.62\n"
+                                 "S4,Nowhere,,\n");
+  // Two routes share a short name and a third is named like the second
+  // pattern of the first.
+  write_file(feed / "routes.txt", "route_id,route_short_name,route_long_name\n"
+                                  "R1,1,\n"
+                                  "R2,1,\n"
+                                  "R3,1 #2,\n");
+  write_file(feed / "trips.txt", "route_id,trip_id\n"
+                                 "R1,T1\n"
+                                 "R1,T2\n"
+                                 "R2,T3\n"
+                                 "R3,T4\n");
+  write_file(feed / "stop_times.txt",
+             "trip_id,stop_id,stop_sequence,shape_dist_traveled\n"
+             "T1,S1,1,\nT1,S2,2,\n"
+             "T2,S1,1,\nT2,S2,2,\nT2,S3,3,\n"
+             "T3,S3,1,\nT3,S2,2,\nT3,S1,3,\nT3,S3,4,\n"
+             "T4,S1,1,\nT4,S4,2,\nT4,S3,3,\nT4,S2,4,\nT4,S1,5,\n"
+             "T4,S3,6,\n");
+
+  CHECK_EQUAL(run("make_base", make_base_input(""), nullptr,
+                  "--gtfs \"" + feed.string() + "\""),
+              0);
+
+  std::string output;
+  CHECK_EQUAL(
+      run("process_requests",
+          process_input(R"json({"id": 1, "type": "Bus", "name": "1"},
+                           {"id": 2, "type": "Bus", "name": "1 #2"},
+                           {"id": 3, "type": "Bus", "name": "1 (R2)"},
+                           {"id": 4, "type": "Bus", "name": "1 #2 (R3)"},
+                           {"id": 5, "type": "Stop", "name": "Nowhere"})json"),
+          &output),
+      0);
+
+  const auto answers = parse(output).get_root().as_array();
+  const int stop_counts[] = {2, 3, 4, 5};
+
+  for (int i = 0; i < 4; ++i) {
+    CHECK_EQUAL(answers.at(i).as_dict().at("stop_count").as_int(),
+                stop_counts[i]);
+  }
+
+  // A stop without coordinates is left out rather than put at NaN.
+  CHECK(answers.at(4).as_dict().count("error_message"));
+}
+
+void test_stop_search_cyrillic() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "Электросети", "latitude": 55.6,
+     "longitude": 37.6, "road_distances": {}},
+    {"type": "Stop", "name": "Электрозавод", "latitude": 55.7,
+     "longitude": 37.7, "road_distances": {}})";
+
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+
+  std::string output;
+  CHECK_EQUAL(run("process_requests",
+                  process_input(R"({"id": 1, "type": "StopSearch",
+                                   "query": "Электросетт", "limit": 5,
+                                   "max_edits": 1})"),
+                  &output),
+              0);
+
+  const auto answer = parse(output).get_root().as_array().at(0).as_dict();
+  const auto &stops = answer.at("stops").as_array();
+  CHECK_EQUAL(stops.size(), 1u);
+  CHECK_EQUAL(stops.at(0).as_string(), "Электросети");
+}
+
+void test_delta_matches_rebuild() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.6, "longitude": 37.6,
+     "road_distances": {"B": 1000}},
+    {"type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.61,
+     "road_distances": {"D": 2500}},
+    {"type": "Stop", "name": "D", "latitude": 55.63, "longitude": 37.63,
+     "road_distances": {}},
+    {"type": "Bus", "name": "1", "stops": ["A", "B"], "is_roundtrip": false},
+    {"type": "Bus", "name": "2", "stops": ["B", "D"], "is_roundtrip": false})";
+  const std::string stat_requests = R"(
+    {"id": 1, "type": "Bus", "name": "1"},
+    {"id": 2, "type": "Bus", "name": "2"},
+    {"id": 3, "type": "Bus", "name": "3"},
+    {"id": 4, "type": "Stop", "name": "A"},
+    {"id": 5, "type": "Stop", "name": "B"},
+    {"id": 6, "type": "Stop", "name": "C"},
+    {"id": 7, "type": "Stop", "name": "D"},
+    {"id": 8, "type": "Route", "from": "A", "to": "C"},
+    {"id": 9, "type": "StopSearch", "query": "C", "limit": 5},
+    {"id": 10, "type": "Map"},
+    {"id": 11, "type": "Network"})";
+
+  // The delta adds C, moves B, changes a distance, replaces bus 2 with
+  // bus 3 and removes D; the malformed removal must not stop the rest.
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+  CHECK_EQUAL(
+      run("apply_delta",
+          "{" + serialization_settings() + R"(, "delta_requests": [
+    {"type": "Stop", "action": "add", "name": "C", "latitude": 55.62,
+     "longitude": 37.62, "road_distances": {"A": 3000, "B": 2000}},
+    {"type": "Stop", "action": "modify", "name": "B", "latitude": 55.615,
+     "longitude": 37.615},
+    {"type": "Distance", "action": "add", "from": "A", "to": "B",
+     "distance": 1500},
+    {"type": "Bus", "action": "remove", "name": "2"},
+    {"type": "Bus", "action": "add", "name": "3", "stops": ["B", "C"],
+     "is_roundtrip": false},
+    {"type": "Stop", "action": "remove"},
+    {"type": "Stop", "action": "remove", "name": "D"}]})"),
+      0);
+
+  std::string delta_output;
+  CHECK_EQUAL(run("process_requests", process_input(stat_requests),
+                  &delta_output),
+              0);
+
+  const std::string rebuilt = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.6, "longitude": 37.6,
+     "road_distances": {"B": 1500}},
+    {"type": "Stop", "name": "B", "latitude": 55.615, "longitude": 37.615,
+     "road_distances": {}},
+    {"type": "Stop", "name": "C", "latitude": 55.62, "longitude": 37.62,
+     "road_distances": {"A": 3000, "B": 2000}},
+    {"type": "Bus", "name": "1", "stops": ["A", "B"], "is_roundtrip": false},
+    {"type": "Bus", "name": "3", "stops": ["B", "C"], "is_roundtrip": false})";
+
+  CHECK_EQUAL(run("make_base", make_base_input(rebuilt)), 0);
+
+  std::string rebuilt_output;
+  CHECK_EQUAL(run("process_requests", process_input(stat_requests),
+                  &rebuilt_output),
+              0);
+
+  CHECK(parse(delta_output) == parse(rebuilt_output));
+}
+
+void test_base_formats_round_trip() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.611087, "longitude": 37.20829,
+     "road_distances": {"B": 3900}},
+    {"type": "Stop", "name": "B", "latitude": 55.595884, "longitude": 37.209755,
+     "road_distances": {"C": 9900, "A": 4000}},
+    {"type": "Stop", "name": "C", "latitude": 55.632761, "longitude": 37.333324,
+     "road_distances": {}},
+    {"type": "Stop", "name": "D", "latitude": 55.574371, "longitude": 37.6517,
+     "road_distances": {"C": 7500}},
+    {"type": "Bus", "name": "14", "stops": ["A", "B", "C", "A"],
+     "is_roundtrip": true},
+    {"type": "Bus", "name": "750", "stops": ["D", "C", "B"],
+     "is_roundtrip": false})";
+  const std::string stat_requests = R"(
+    {"id": 1, "type": "Bus", "name": "14"},
+    {"id": 2, "type": "Bus", "name": "750"},
+    {"id": 3, "type": "Stop", "name": "B"},
+    {"id": 4, "type": "Route", "from": "A", "to": "D"},
+    {"id": 5, "type": "StopSearch", "query": "C", "limit": 5},
+    {"id": 6, "type": "StopsInArea", "min_latitude": 55.59,
+     "min_longitude": 37.2, "max_latitude": 55.62, "max_longitude": 37.3},
+    {"id": 7, "type": "DirectBuses", "from": "B", "to": "C"},
+    {"id": 8, "type": "SegmentLength", "name": "750", "from_index": 0,
+     "to_index": 3},
+    {"id": 9, "type": "Network"},
+    {"id": 10, "type": "Map"})";
+
+  std::string expected;
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+  CHECK_EQUAL(run("process_requests", process_input(stat_requests),
+                  &expected),
+              0);
+
+  // Every format answers the same as the protobuf base it is compared
+  // with, with and without precomputed answers.
+  const std::string formats[] = {
+      R"(, "format": "compact")", R"(, "format": "flat")",
+      R"(, "precompute_answers": true)",
+      R"(, "format": "flat", "precompute_answers": true)"};
+
+  for (const std::string &format : formats) {
+    std::string output;
+    CHECK_EQUAL(run("make_base", make_base_input(base, format)), 0);
+    CHECK_EQUAL(run("process_requests", process_input(stat_requests, format),
+                    &output),
+                0);
+    CHECK(parse(output) == parse(expected));
+  }
+
+  // A flat base is the same file every time, padding included.
+  const std::string flat = R"(, "format": "flat")";
+  CHECK_EQUAL(run("make_base", make_base_input(base, flat)), 0);
+  const std::string first_base = read_file(directory / "base.db");
+  CHECK_EQUAL(run("make_base", make_base_input(base, flat)), 0);
+  CHECK(read_file(directory / "base.db") == first_base);
+}
+
+void test_nearest_stops_count() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.6, "longitude": 37.6,
+     "road_distances": {}},
+    {"type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.61,
+     "road_distances": {}})";
+
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+
+  std::string output;
+  CHECK_EQUAL(run("process_requests",
+                  process_input(R"(
+    {"id": 1, "type": "NearestStops", "latitude": 55.6, "longitude": 37.6,
+     "count": -1},
+    {"id": 2, "type": "NearestStops", "latitude": 55.6, "longitude": 37.6,
+     "count": 1})"),
+                  &output),
+              0);
+
+  const auto answers = parse(output).get_root().as_array();
+  CHECK_EQUAL(answers.at(0).as_dict().at("error_message").as_string(),
+              "invalid count");
+  CHECK_EQUAL(answers.at(1).as_dict().at("stops").as_array().size(), 1u);
+}
+
+// Route length of bus "1" after applying the distance changes to the base.
+int route_length_after(const std::string &delta_requests) {
+  if (!delta_requests.empty()) {
+    CHECK_EQUAL(run("apply_delta", "{" + serialization_settings() +
+                                       R"(, "delta_requests": [)" +
+                                       delta_requests + "]}"),
+                0);
+  }
+
+  std::string output;
+  CHECK_EQUAL(run("process_requests",
+                  process_input(R"({"id": 1, "type": "Bus", "name": "1"})"),
+                  &output),
+              0);
+
+  return parse(output).get_root().as_array().at(0).as_dict().at(
+      "route_length").as_int();
+}
+
+void test_distance_directions() {
+  const std::string base = R"(
+    {"type": "Stop", "name": "A", "latitude": 55.6, "longitude": 37.6,
+     "road_distances": {"B": 1000}},
+    {"type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.61,
+     "road_distances": {}},
+    {"type": "Bus", "name": "1", "stops": ["A", "B"], "is_roundtrip": false})";
+
+  CHECK_EQUAL(run("make_base", make_base_input(base)), 0);
+
+  // The way back takes the distance given for the way there until it is
+  // given itself, and again once that is removed.
+  CHECK_EQUAL(route_length_after(""), 2000);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "add",
+                                     "from": "B", "to": "A",
+                                     "distance": 1500})"),
+              2500);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "add",
+                                     "from": "A", "to": "B",
+                                     "distance": 700})"),
+              2200);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "remove",
+                                     "from": "B", "to": "A"})"),
+              1400);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "add",
+                                     "from": "B", "to": "A",
+                                     "distance": 900})"),
+              1600);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "remove",
+                                     "from": "A", "to": "B"})"),
+              1800);
+  CHECK_EQUAL(route_length_after(R"({"type": "Distance", "action": "remove",
+                                     "from": "B", "to": "A"})"),
+              0);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: cli_test <transport_catalogue> <scratch directory>\n";
+    return 1;
+  }
+
+  binary = argv[1];
+  directory = argv[2];
+  std::filesystem::create_directories(directory);
+
+  tests::TestRunner runner;
+
+  RUN_TEST(runner, test_duplicate_names);
+  RUN_TEST(runner, test_gtfs_import);
+  RUN_TEST(runner, test_stop_search_cyrillic);
+  RUN_TEST(runner, test_delta_matches_rebuild);
+  RUN_TEST(runner, test_distance_directions);
+  RUN_TEST(runner, test_nearest_stops_count);
+  RUN_TEST(runner, test_base_formats_round_trip);
+
+  return runner.get_failed();
+}
\ No newline at end of file
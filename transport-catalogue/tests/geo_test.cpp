@@ -0,0 +1,115 @@
+#include "geo.h"
+#include "test_framework.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using geo::Coordinates;
+using geo::TrigTable;
+
+namespace {
+
+// The batch kernel agrees with geo::compute_distance exactly for coincident
+// points and up to rounding otherwise; acos loses precision for points less
+// than a metre apart, hence the absolute margin.
+void check_same_distance(double batch_length, Coordinates from,
+                         Coordinates to) {
+  const double length = geo::compute_distance(from, to);
+
+  if (from == to) {
+    CHECK_EQUAL(batch_length, 0.);
+  } else {
+    CHECK(std::abs(batch_length - length) <= 1e-9 * length + 0.5);
+  }
+}
+
+std::vector<Coordinates> make_points() {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> latitude(-89.9, 89.9);
+  std::uniform_real_distribution<double> longitude(-180., 180.);
+  std::uniform_real_distribution<double> offset(-0.01, 0.01);
+
+  std::vector<Coordinates> points;
+  for (int i = 0; i < 500; ++i) {
+    points.push_back({latitude(generator), longitude(generator)});
+    // A close neighbour, a repeat and a point near the antipode; at the
+    // antipode itself the rounded cosine may fall below -1, which the
+    // kernel clamps and compute_distance does not.
+    points.push_back({points.back().latitude + offset(generator),
+                      points.back().longitude + offset(generator)});
+    points.push_back(points[points.size() - 2]);
+    points.push_back({0.5 - points.back().latitude,
+                      points.back().longitude > 0.
+                          ? points.back().longitude - 180.
+                          : points.back().longitude + 180.});
+  }
+
+  // At this latitude the rounded cosine of a zero angle is below 1.
+  points.push_back({55.650877060830574, 37.5});
+  points.push_back({55.650877060830574, 37.5});
+
+  return points;
+}
+
+} // end namespace
+
+void test_compute_distances_matches_scalar() {
+  const std::vector<Coordinates> points = make_points();
+  const TrigTable trig_table(points);
+
+  std::vector<uint32_t> from;
+  std::vector<uint32_t> to;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<uint32_t> index(
+      0, static_cast<uint32_t>(points.size() - 1));
+
+  for (uint32_t i = 0; i < points.size(); ++i) {
+    from.push_back(i);
+    to.push_back(i);
+    from.push_back(i);
+    to.push_back(index(generator));
+  }
+
+  std::vector<double> lengths(from.size());
+  trig_table.compute_distances(from.data(), to.data(), lengths.data(),
+                               lengths.size());
+
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    check_same_distance(lengths[i], points[from[i]], points[to[i]]);
+  }
+}
+
+void test_compute_path_distances_matches_scalar() {
+  const std::vector<Coordinates> points = make_points();
+  const TrigTable trig_table(points);
+
+  std::vector<double> lengths(points.size() - 1);
+  trig_table.compute_path_distances(lengths.data());
+
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    check_same_distance(lengths[i], points[i], points[i + 1]);
+  }
+}
+
+void test_compute_path_distances_short() {
+  double length = -1.;
+
+  TrigTable trig_table;
+  trig_table.compute_path_distances(&length);
+  trig_table.add({55.6, 37.6});
+  trig_table.compute_path_distances(&length);
+
+  CHECK_EQUAL(length, -1.);
+}
+
+int main() {
+  tests::TestRunner runner;
+
+  RUN_TEST(runner, test_compute_distances_matches_scalar);
+  RUN_TEST(runner, test_compute_path_distances_matches_scalar);
+  RUN_TEST(runner, test_compute_path_distances_short);
+
+  return runner.get_failed();
+}
\ No newline at end of file
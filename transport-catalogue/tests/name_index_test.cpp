@@ -0,0 +1,60 @@
+#include "name_index.h"
+#include "test_framework.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using domain::NameIndex;
+
+void test_finds_every_name() {
+  std::vector<std::string> storage;
+  for (int i = 0; i < 1000; ++i) {
+    storage.push_back("Stop " + std::to_string(i));
+  }
+
+  std::vector<std::string_view> names(storage.begin(), storage.end());
+  NameIndex index;
+  index.build(names);
+
+  for (uint32_t id = 0; id < names.size(); ++id) {
+    CHECK_EQUAL(*index.find(names[id]), id);
+  }
+}
+
+void test_duplicate_names_keep_first_id() {
+  const std::vector<std::string_view> names{"A", "B", "A", "C", "B", "A"};
+  NameIndex index;
+  index.build(names);
+
+  CHECK_EQUAL(*index.find("A"), 0u);
+  CHECK_EQUAL(*index.find("B"), 1u);
+  CHECK_EQUAL(*index.find("C"), 3u);
+}
+
+void test_all_names_equal() {
+  const std::vector<std::string_view> names(50, "Same");
+  NameIndex index;
+  index.build(names);
+
+  CHECK_EQUAL(*index.find("Same"), 0u);
+}
+
+void test_empty() {
+  NameIndex index;
+  index.build({});
+
+  CHECK(index.empty());
+  CHECK(!index.find("A"));
+}
+
+int main() {
+  tests::TestRunner runner;
+
+  RUN_TEST(runner, test_finds_every_name);
+  RUN_TEST(runner, test_duplicate_names_keep_first_id);
+  RUN_TEST(runner, test_all_names_equal);
+  RUN_TEST(runner, test_empty);
+
+  return runner.get_failed();
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "name_trie.h"
+#include "test_framework.h"
+
+#include <string_view>
+#include <vector>
+
+using domain::NameTrie;
+
+void test_find_prefix() {
+  const std::vector<std::string_view> names{"Tolstoy", "Tverskaya", "Arbat",
+                                            "Tolmachi"};
+  NameTrie trie;
+  trie.build(names);
+
+  const auto ids = trie.find_prefix("Tol", 10);
+  CHECK_EQUAL(ids.size(), 2u);
+  CHECK_EQUAL(ids[0], 3u);
+  CHECK_EQUAL(ids[1], 0u);
+  CHECK(trie.find_prefix("X", 10).empty());
+}
+
+void test_find_similar_ascii() {
+  const std::vector<std::string_view> names{"Arbat", "Arbatskaya", "Abrat"};
+  NameTrie trie;
+  trie.build(names);
+
+  const auto ids = trie.find_similar("Arbat", 2, 10);
+  CHECK_EQUAL(ids.size(), 2u);
+  CHECK_EQUAL(ids[0], 0u);
+  CHECK_EQUAL(ids[1], 2u);
+}
+
+void test_find_similar_counts_code_points() {
+  const std::vector<std::string_view> names{"Электросети", "Электрозавод",
+                                            "Электросила"};
+  NameTrie trie;
+  trie.build(names);
+
+  // "т" and "и" differ in both of their bytes, yet are one edit apart.
+  const auto ids = trie.find_similar("Электросетт", 1, 10);
+  CHECK_EQUAL(ids.size(), 1u);
+  CHECK_EQUAL(ids[0], 0u);
+
+  CHECK_EQUAL(trie.find_similar("Электросил", 1, 10).size(), 1u);
+  CHECK_EQUAL(trie.find_similar("Электросила", 0, 10).size(), 1u);
+  CHECK(trie.find_similar("Электро", 3, 10).empty());
+}
+
+void test_find_similar_mixed_widths() {
+  // An ASCII letter in place of a Cyrillic one is still a single edit.
+  const std::vector<std::string_view> names{"Сокол", "Cокол"};
+  NameTrie trie;
+  trie.build(names);
+
+  CHECK_EQUAL(trie.find_similar("Сокол", 1, 10).size(), 2u);
+  CHECK_EQUAL(trie.find_similar("окол", 1, 10).size(), 2u);
+}
+
+int main() {
+  tests::TestRunner runner;
+
+  RUN_TEST(runner, test_find_prefix);
+  RUN_TEST(runner, test_find_similar_ascii);
+  RUN_TEST(runner, test_find_similar_counts_code_points);
+  RUN_TEST(runner, test_find_similar_mixed_widths);
+
+  return runner.get_failed();
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "spatial_index.h"
+#include "test_framework.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using domain::SpatialIndex;
+using geo::Coordinates;
+
+namespace {
+
+std::vector<Coordinates> make_points(double min_latitude, double max_latitude,
+                                     double min_longitude,
+                                     double max_longitude, int count,
+                                     unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> latitude(min_latitude, max_latitude);
+  std::uniform_real_distribution<double> longitude(min_longitude,
+                                                   max_longitude);
+
+  std::vector<Coordinates> points;
+  for (int i = 0; i < count; ++i) {
+    points.push_back({latitude(generator), longitude(generator)});
+  }
+
+  return points;
+}
+
+// Compares find_nearest with sorting all points by distance; only the
+// distances are compared, since equally distant points may come in any
+// order.
+void check_nearest(const std::vector<Coordinates> &points,
+                   const std::vector<Coordinates> &queries, size_t count) {
+  SpatialIndex index;
+  index.build(points);
+
+  for (const Coordinates &query : queries) {
+    std::vector<double> expected;
+    for (const Coordinates &point : points) {
+      expected.push_back(geo::compute_distance(query, point));
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.resize(std::min(count, expected.size()));
+
+    const auto nearest = index.find_nearest(query, count);
+    CHECK_EQUAL(nearest.size(), expected.size());
+
+    for (size_t i = 0; i < nearest.size(); ++i) {
+      CHECK_EQUAL(nearest[i].second, expected[i]);
+      CHECK_EQUAL(nearest[i].second,
+                  geo::compute_distance(query, points[nearest[i].first]));
+    }
+  }
+}
+
+} // end namespace
+
+void test_nearest_in_a_city() {
+  const auto points = make_points(55.5, 55.9, 37.3, 37.9, 2000, 1);
+  check_nearest(points, make_points(55.4, 56., 37.2, 38., 50, 2), 10);
+}
+
+void test_nearest_at_high_latitude() {
+  // Meridians converge, so a box is much narrower at its top than at its
+  // bottom, and the nearest point of a box may be inside an edge.
+  const auto points = make_points(60., 89.9, -30., 30., 1000, 18);
+  check_nearest(points, make_points(60., 89.9, -30., 30., 100, 118), 10);
+}
+
+void test_nearest_across_antimeridian() {
+  auto points = make_points(-20., 20., 170., 180., 1000, 5);
+  const auto west = make_points(-20., 20., -180., -170., 1000, 6);
+  points.insert(points.end(), west.begin(), west.end());
+
+  const std::vector<Coordinates> queries{
+      {0., 179.99}, {0., -179.99}, {5., 180.}, {-5., -180.}, {19., 175.}};
+  check_nearest(points, queries, 10);
+}
+
+void test_nearest_count() {
+  const auto points = make_points(55.5, 55.9, 37.3, 37.9, 100, 7);
+  SpatialIndex index;
+  index.build(points);
+
+  CHECK(index.find_nearest({55.7, 37.6}, 0).empty());
+  CHECK_EQUAL(index.find_nearest({55.7, 37.6}, 1000).size(), points.size());
+}
+
+void test_in_area() {
+  const auto points = make_points(55.5, 55.9, 37.3, 37.9, 2000, 8);
+  SpatialIndex index;
+  index.build(points);
+
+  const geo::BoundingBox areas[] = {{55.6, 37.5, 55.7, 37.6},
+                                    {55., 37., 56., 38.},
+                                    {55.8, 37.8, 55.8, 37.8},
+                                    {10., 10., 11., 11.}};
+
+  for (const geo::BoundingBox &area : areas) {
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < points.size(); ++id) {
+      if (area.contains(points[id])) {
+        expected.push_back(id);
+      }
+    }
+
+    auto found = index.find_in_area(area);
+    std::sort(found.begin(), found.end());
+    CHECK(found == expected);
+  }
+}
+
+int main() {
+  tests::TestRunner runner;
+
+  RUN_TEST(runner, test_nearest_in_a_city);
+  RUN_TEST(runner, test_nearest_at_high_latitude);
+  RUN_TEST(runner, test_nearest_across_antimeridian);
+  RUN_TEST(runner, test_nearest_count);
+  RUN_TEST(runner, test_in_area);
+
+  return runner.get_failed();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Minimal test harness: a failed check throws, run_test reports it and the
+// test binary exits with the number of failed tests, which ctest reads.
+namespace tests {
+
+class TestFailure : public std::runtime_error {
+public:
+  using runtime_error::runtime_error;
+};
+
+inline void check(bool condition, const std::string &expression,
+                  const char *file, int line) {
+  if (!condition) {
+    std::ostringstream message;
+    message << file << ":" << line << ": check failed: " << expression;
+    throw TestFailure(message.str());
+  }
+}
+
+template <typename Lhs, typename Rhs>
+void check_equal(const Lhs &lhs, const Rhs &rhs, const std::string &expression,
+                 const char *file, int line) {
+  if (!(lhs == rhs)) {
+    std::ostringstream message;
+    message << file << ":" << line << ": " << expression << ": " << lhs
+            << " != " << rhs;
+    throw TestFailure(message.str());
+  }
+}
+
+class TestRunner {
+public:
+  void run_test(const std::string &name, const std::function<void()> &test) {
+    try {
+      test();
+      std::cerr << name << " OK\n";
+    } catch (const std::exception &e) {
+      ++failed_;
+      std::cerr << name << " FAILED: " << e.what() << "\n";
+    }
+  }
+
+  int get_failed() const { return failed_; }
+
+private:
+  int failed_ = 0;
+};
+
+} // end namespace tests
+
+#define CHECK(expr)                                                            \
+  tests::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define CHECK_EQUAL(lhs, rhs)                                                  \
+  tests::check_equal((lhs), (rhs), #lhs " == " #rhs, __FILE__, __LINE__)
+#define RUN_TEST(runner, func) (runner).run_test(#func, func)
\ No newline at end of file
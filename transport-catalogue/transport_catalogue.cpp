@@ -2,68 +2,429 @@
 
 namespace transport_catalogue {
 
-void TransportCatalogue::add_stop(Stop &&stop) {
+TransportCatalogue::TransportCatalogue()
+    : arena_(std::make_unique<MemoryArena>()), names_(arena_.get()),
+      stops(arena_.get()), stopname_to_stop(arena_.get()),
+      buses(arena_.get()), busname_to_bus(arena_.get()) {}
+
+Stop *TransportCatalogue::add_stop(Stop &&stop) {
+  stop.name = names_.add(stop.name);
+
   stops.push_back(std::move(stop));
   Stop *stop_buf = &stops.back();
-  stopname_to_stop.insert(
-      transport_catalogue::StopMap::value_type(stop_buf->name, stop_buf));
+  if (keeps_network_stats_) {
+    stats_.add_stop(stop_buf->name);
+  }
+
+  if (stop_index_.find(stop_buf->name) != stops.size() - 1) {
+    stopname_to_stop.insert(
+        transport_catalogue::StopMap::value_type(stop_buf->name, stop_buf));
+  }
+
+  return stop_buf;
 }
 
 void TransportCatalogue::add_bus(Bus &&bus) {
   Bus *bus_buf;
 
+  bus.name = names_.add(bus.name);
   buses.push_back(std::move(bus));
   bus_buf = &buses.back();
-  busname_to_bus.insert(BusMap::value_type(bus_buf->name, bus_buf));
 
-  for (Stop *stop : bus_buf->stops) {
-    stop->buses.push_back(bus_buf);
+  if (bus_index_.find(bus_buf->name) != buses.size() - 1) {
+    busname_to_bus.insert(BusMap::value_type(bus_buf->name, bus_buf));
   }
 
-  bus_buf->route_length = get_distance_to_bus(bus_buf);
+  attach_bus(bus_buf);
+}
+
+// Position of the neighbour in a row of distances sorted by neighbour.
+template <typename Distances>
+static auto find_distance(Distances &stop_distances, const Stop *neighbour) {
+  return std::lower_bound(stop_distances.begin(), stop_distances.end(),
+                          neighbour,
+                          [](const RoadDistance &entry, const Stop *stop) {
+                            return entry.neighbour < stop;
+                          });
 }
 
 void TransportCatalogue::add_distance(const std::vector<Distance> &distances) {
 
   for (auto distance : distances) {
-    auto dist_pair = std::make_pair(distance.start, distance.end);
-    distance_to_stop.insert(
-        DistanceMap::value_type(dist_pair, distance.distance));
+    // A distance to a stop that was not found is dropped.
+    if (!distance.start || !distance.end) {
+      continue;
+    }
+
+    auto &stop_distances = distance.start->distances;
+    auto it = find_distance(stop_distances, distance.end);
+
+    if (it != stop_distances.end() && it->neighbour == distance.end) {
+      it->distance = distance.distance;
+      it->is_given = true;
+    } else {
+      stop_distances.insert(it, {distance.end, distance.distance, true});
+    }
+
+    // The way back takes this distance unless it was given itself.
+    auto &end_distances = distance.end->distances;
+    it = find_distance(end_distances, distance.start);
+
+    if (it == end_distances.end() || it->neighbour != distance.start) {
+      end_distances.insert(it, {distance.start, distance.distance, false});
+    } else if (!it->is_given) {
+      it->distance = distance.distance;
+    }
+
+    update_route_length(distance.start);
+    update_route_length(distance.end);
   }
 }
 
-Bus *TransportCatalogue::get_bus(std::string_view bus_name) {
-  if (busname_to_bus.empty()) {
-    return nullptr;
+bool TransportCatalogue::update_stop(std::string_view stop_name,
+                                     geo::Coordinates coordinates) {
+  Stop *stop = get_stop(stop_name);
+
+  if (!stop) {
+    return false;
   }
 
-  if (busname_to_bus.count(bus_name)) {
-    return busname_to_bus.at(bus_name);
-  } else {
-    return nullptr;
+  stop->latitude = coordinates.latitude;
+  stop->longitude = coordinates.longitude;
+
+  for (Bus *bus : stop->buses) {
+    const double geo_length = get_length(bus);
+
+    if (keeps_network_stats_) {
+      stats_.update_bus(bus->name, bus->route_length, bus->geo_length,
+                        bus->route_length, geo_length);
+    }
+    bus->geo_length = geo_length;
   }
+
+  return true;
 }
 
-Stop *TransportCatalogue::get_stop(std::string_view stop_name) {
-  if (stopname_to_stop.empty()) {
-    return nullptr;
+bool TransportCatalogue::update_bus(Bus &&bus) {
+  Bus *bus_buf = get_bus(bus.name);
+
+  if (!bus_buf) {
+    return false;
   }
 
-  if (stopname_to_stop.count(stop_name)) {
-    return stopname_to_stop.at(stop_name);
+  detach_bus(bus_buf);
+
+  bus_buf->stops.assign(bus.stops.begin(), bus.stops.end());
+  bus_buf->is_roundtrip = bus.is_roundtrip;
+
+  attach_bus(bus_buf);
+
+  return true;
+}
+
+bool TransportCatalogue::remove_distance(Stop *start, Stop *end) {
+  auto &stop_distances = start->distances;
+  auto it = find_distance(stop_distances, end);
+
+  if (it == stop_distances.end() || it->neighbour != end || !it->is_given) {
+    return false;
+  }
+
+  if (start == end) {
+    stop_distances.erase(it);
   } else {
-    return nullptr;
+    // A distance given the other way now serves this direction too;
+    // otherwise the copy of the removed one on the way back goes as well.
+    auto &end_distances = end->distances;
+    auto back = find_distance(end_distances, start);
+    const bool has_back =
+        back != end_distances.end() && back->neighbour == start;
+
+    if (has_back && back->is_given) {
+      it->distance = back->distance;
+      it->is_given = false;
+    } else {
+      stop_distances.erase(it);
+
+      if (has_back) {
+        end_distances.erase(back);
+      }
+    }
+  }
+
+  update_route_length(start);
+  update_route_length(end);
+
+  return true;
+}
+
+bool TransportCatalogue::remove_bus(std::string_view bus_name) {
+  Bus *bus = get_bus(bus_name);
+
+  if (!bus) {
+    return false;
+  }
+
+  detach_bus(bus);
+  busname_to_bus.erase(bus->name);
+
+  Bus *last = &buses.back();
+
+  if (bus != last) {
+    for (Stop *stop : last->stops) {
+      std::replace(stop->buses.begin(), stop->buses.end(), last, bus);
+    }
+
+    *bus = std::move(*last);
+    busname_to_bus.insert_or_assign(bus->name, bus);
+  }
+
+  buses.pop_back();
+
+  return true;
+}
+
+bool TransportCatalogue::remove_stop(std::string_view stop_name) {
+  Stop *stop = get_stop(stop_name);
+
+  if (!stop || !stop->buses.empty()) {
+    return false;
+  }
+
+  stopname_to_stop.erase(stop->name);
+  if (keeps_network_stats_) {
+    stats_.remove_stop(stop->name, 0);
+  }
+
+  Stop *last = &stops.back();
+
+  for (Stop &other : stops) {
+    auto &stop_distances = other.distances;
+    stop_distances.erase(std::remove_if(stop_distances.begin(),
+                                        stop_distances.end(),
+                                        [stop](const auto &entry) {
+                                          return entry.neighbour == stop;
+                                        }),
+                         stop_distances.end());
+
+    if (stop != last) {
+      for (auto &entry : stop_distances) {
+        if (entry.neighbour == last) {
+          entry.neighbour = stop;
+        }
+      }
+      std::sort(stop_distances.begin(), stop_distances.end(),
+                [](const RoadDistance &lhs, const RoadDistance &rhs) {
+                  return lhs.neighbour < rhs.neighbour;
+                });
+    }
+  }
+
+  if (stop != last) {
+    for (Bus *bus : last->buses) {
+      std::replace(bus->stops.begin(), bus->stops.end(), last, stop);
+    }
+
+    *stop = std::move(*last);
+    stopname_to_stop.insert_or_assign(stop->name, stop);
+  }
+
+  stops.pop_back();
+
+  return true;
+}
+
+void TransportCatalogue::attach_bus(Bus *bus) {
+  for (Stop *stop : bus->stops) {
+    auto &stop_buses = stop->buses;
+
+    if (std::find(stop_buses.begin(), stop_buses.end(), bus) ==
+        stop_buses.end()) {
+      stop_buses.push_back(bus);
+
+      if (keeps_network_stats_) {
+        stats_.update_stop(stop->name, stop_buses.size() - 1,
+                           stop_buses.size());
+      }
+    }
+  }
+
+  bus->route_length = get_distance_to_bus(bus);
+  bus->geo_length = get_length(bus);
+  if (keeps_network_stats_) {
+    stats_.add_bus(bus->name, bus->route_length, bus->geo_length);
+  }
+}
+
+void TransportCatalogue::detach_bus(Bus *bus) {
+  if (keeps_network_stats_) {
+    stats_.remove_bus(bus->name, bus->route_length, bus->geo_length);
+  }
+
+  for (Stop *stop : bus->stops) {
+    auto &stop_buses = stop->buses;
+    const size_t bus_count = stop_buses.size();
+
+    stop_buses.erase(std::remove(stop_buses.begin(), stop_buses.end(), bus),
+                     stop_buses.end());
+
+    if (keeps_network_stats_ && stop_buses.size() != bus_count) {
+      stats_.update_stop(stop->name, bus_count, stop_buses.size());
+    }
+  }
+}
+
+void TransportCatalogue::update_route_length(const Stop *stop) {
+  for (Bus *bus : stop->buses) {
+    const size_t route_length = get_distance_to_bus(bus);
+
+    if (keeps_network_stats_) {
+      stats_.update_bus(bus->name, bus->route_length, bus->geo_length,
+                        route_length, bus->geo_length);
+    }
+    bus->route_length = route_length;
+  }
+}
+
+void TransportCatalogue::refresh_network_stats() {
+  if (!stats_.is_stale()) {
+    return;
+  }
+
+  std::vector<NetworkStats::Entry> stop_entries;
+  std::vector<NetworkStats::Entry> bus_entries;
+
+  for (const Stop &stop : stops) {
+    stop_entries.push_back({stop.name, stop.buses.size()});
+  }
+  for (const Bus &bus : buses) {
+    bus_entries.push_back({bus.name, bus.route_length});
+  }
+
+  stats_.rebuild_rankings(std::move(stop_entries), std::move(bus_entries));
+}
+
+void TransportCatalogue::set_network_stats(NetworkStats stats) {
+  stats_ = std::move(stats);
+}
+
+void TransportCatalogue::keep_network_stats(bool keeps) {
+  keeps_network_stats_ = keeps;
+}
+
+const NetworkStats &TransportCatalogue::get_network_stats() const {
+  return stats_;
+}
+
+std::string_view TransportCatalogue::add_name(std::string_view name) {
+  return names_.add(name);
+}
+
+void TransportCatalogue::set_names(std::string_view blob) {
+  names_.assign(blob);
+}
+
+const NameArena &TransportCatalogue::get_names() const { return names_; }
+
+FrozenCatalogue TransportCatalogue::freeze() const {
+  return FrozenCatalogue(*this);
+}
+
+void TransportCatalogue::build_name_index() {
+  std::vector<std::string_view> names;
+
+  names.reserve(stops.size());
+  for (const Stop &stop : stops) {
+    names.push_back(stop.name);
+  }
+  stop_index_.build(names);
+
+  names.clear();
+  names.reserve(buses.size());
+  for (const Bus &bus : buses) {
+    names.push_back(bus.name);
+  }
+  bus_index_.build(names);
+}
+
+void TransportCatalogue::set_name_index(NameIndex stop_index,
+                                        NameIndex bus_index) {
+  stop_index_ = std::move(stop_index);
+  bus_index_ = std::move(bus_index);
+}
+
+const NameIndex &TransportCatalogue::get_stop_index() const {
+  return stop_index_;
+}
+
+const NameIndex &TransportCatalogue::get_bus_index() const {
+  return bus_index_;
+}
+
+void TransportCatalogue::build_name_trie() {
+  std::vector<std::string_view> names;
+
+  names.reserve(stops.size());
+  for (const Stop &stop : stops) {
+    names.push_back(stop.name);
+  }
+
+  stop_trie_.build(names);
+}
+
+void TransportCatalogue::set_name_trie(NameTrie stop_trie) {
+  stop_trie_ = std::move(stop_trie);
+}
+
+const NameTrie &TransportCatalogue::get_stop_trie() const {
+  return stop_trie_;
+}
+
+void TransportCatalogue::build_spatial_index() {
+  std::vector<geo::Coordinates> points;
+
+  points.reserve(stops.size());
+  for (const Stop &stop : stops) {
+    points.push_back({stop.latitude, stop.longitude});
   }
+
+  spatial_index_.build(points);
 }
 
-std::deque<Stop> TransportCatalogue::get_stops() const { return stops; }
+void TransportCatalogue::set_spatial_index(SpatialIndex spatial_index) {
+  spatial_index_ = std::move(spatial_index);
+}
 
-std::deque<Bus> TransportCatalogue::get_buses() const { return buses; }
+const SpatialIndex &TransportCatalogue::get_spatial_index() const {
+  return spatial_index_;
+}
 
-BusMap TransportCatalogue::get_busname_to_bus() const { return busname_to_bus; }
+Bus *TransportCatalogue::get_bus(std::string_view bus_name) {
+  if (auto id = bus_index_.find(bus_name);
+      id && *id < buses.size() && buses[*id].name == bus_name) {
+    return &buses[*id];
+  }
+
+  auto it = busname_to_bus.find(bus_name);
+  return it != busname_to_bus.end() ? it->second : nullptr;
+}
+
+Stop *TransportCatalogue::get_stop(std::string_view stop_name) {
+  if (auto id = stop_index_.find(stop_name);
+      id && *id < stops.size() && stops[*id].name == stop_name) {
+    return &stops[*id];
+  }
+
+  auto it = stopname_to_stop.find(stop_name);
+  return it != stopname_to_stop.end() ? it->second : nullptr;
+}
+
+const std::pmr::deque<Stop> &TransportCatalogue::get_stops() const {
+  return stops;
+}
 
-StopMap TransportCatalogue::get_stopname_to_stop() const {
-  return stopname_to_stop;
+const std::pmr::deque<Bus> &TransportCatalogue::get_buses() const {
+  return buses;
 }
 
 std::unordered_set<const Stop *> TransportCatalogue::get_uniq_stops(Bus *bus) {
@@ -74,12 +435,24 @@ std::unordered_set<const Stop *> TransportCatalogue::get_uniq_stops(Bus *bus) {
 }
 
 double TransportCatalogue::get_length(Bus *bus) {
-  return transform_reduce(
-      next(bus->stops.begin()), bus->stops.end(), bus->stops.begin(), 0.0,
-      std::plus<>{}, [](const Stop *lhs, const Stop *rhs) {
-        return geo::compute_distance({(*lhs).latitude, (*lhs).longitude},
-                                     {(*rhs).latitude, (*rhs).longitude});
-      });
+  if (bus->stops.size() < 2) {
+    return 0.;
+  }
+
+  // Each stop's trigonometry is computed once for the two segments it ends,
+  // and the segments go through the batch kernel.
+  geo::TrigTable trig_table;
+  for (const Stop *stop : bus->stops) {
+    trig_table.add({stop->latitude, stop->longitude});
+  }
+
+  std::vector<double> segment_lengths(bus->stops.size() - 1);
+  trig_table.compute_path_distances(segment_lengths.data());
+
+  double length =
+      std::accumulate(segment_lengths.begin(), segment_lengths.end(), 0.);
+
+  return bus->is_roundtrip ? length : 2 * length;
 }
 
 std::unordered_set<const Bus *>
@@ -90,33 +463,15 @@ TransportCatalogue::stop_get_uniq_buses(Stop *stop) {
   return unique_stops;
 }
 
-DistanceMap TransportCatalogue::get_distance() const {
-  return distance_to_stop;
-}
-
 size_t TransportCatalogue::get_distance_stop(const Stop *begin,
                                              const Stop *finish) const {
+  // The row holds the way back from the neighbours too, so one search
+  // answers either direction.
+  const auto &stop_distances = begin->distances;
+  auto it = find_distance(stop_distances, finish);
 
-  if (distance_to_stop.empty()) {
-    return 0;
-
-  } else {
-
-    if (const auto &stop_ptr_pair = std::make_pair(begin, finish);
-        distance_to_stop.count(stop_ptr_pair)) {
-
-      return distance_to_stop.at(stop_ptr_pair);
-
-    } else if (const auto &stop_ptr_pair = std::make_pair(finish, begin);
-               distance_to_stop.count(stop_ptr_pair)) {
-
-      return distance_to_stop.at(stop_ptr_pair);
-
-    } else {
-
-      return 0;
-    }
-  }
+  return it != stop_distances.end() && it->neighbour == finish ? it->distance
+                                                               : 0;
 }
 
 size_t TransportCatalogue::get_distance_to_bus(Bus *bus) {
@@ -125,6 +480,10 @@ size_t TransportCatalogue::get_distance_to_bus(Bus *bus) {
 
   for (int i = 0; i < static_cast<int>(stops_size); i++) {
     distance += get_distance_stop(bus->stops[i], bus->stops[i + 1]);
+
+    if (!bus->is_roundtrip) {
+      distance += get_distance_stop(bus->stops[i + 1], bus->stops[i]);
+    }
   }
 
   return distance;
@@ -1,67 +1,110 @@
 #pragma once
+#include <algorithm>
 #include <deque>
+#include <memory>
+#include <memory_resource>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "domain.h"
+#include "frozen_catalogue.h"
+#include "memory_arena.h"
+#include "name_arena.h"
+#include "name_index.h"
+#include "name_trie.h"
+#include "network_stats.h"
+#include "spatial_index.h"
 
 using namespace domain;
 
 namespace transport_catalogue {
 
-struct DistanceHasher {
-  std::hash<const void *> hasher;
-
-  std::size_t operator()(
-      const std::pair<const Stop *, const Stop *> pair_stops) const noexcept {
-    auto hash_1 = static_cast<const void *>(pair_stops.first);
-    auto hash_2 = static_cast<const void *>(pair_stops.second);
-    return hasher(hash_1) * 17 + hasher(hash_2);
-  }
-};
-
-typedef std::unordered_map<std::string_view, Stop *> StopMap;
-typedef std::unordered_map<std::string_view, Bus *> BusMap;
-typedef std::unordered_map<std::pair<const Stop *, const Stop *>, int,
-                           DistanceHasher>
-    DistanceMap;
+typedef std::pmr::unordered_map<std::string_view, Stop *> StopMap;
+typedef std::pmr::unordered_map<std::string_view, Bus *> BusMap;
 
 class TransportCatalogue {
 public:
+  TransportCatalogue();
+  TransportCatalogue(TransportCatalogue &&other) = default;
+  TransportCatalogue &operator=(TransportCatalogue &&other) = delete;
+
   void add_bus(Bus &&bus);
-  void add_stop(Stop &&stop);
+  Stop *add_stop(Stop &&stop);
   void add_distance(const std::vector<Distance> &distances);
 
+  bool update_stop(std::string_view stop_name, geo::Coordinates coordinates);
+  bool update_bus(Bus &&bus);
+
+  bool remove_stop(std::string_view stop_name);
+  bool remove_bus(std::string_view bus_name);
+  bool remove_distance(Stop *start, Stop *end);
+
+  std::string_view add_name(std::string_view name);
+  void set_names(std::string_view blob);
+  const NameArena &get_names() const;
+
+  FrozenCatalogue freeze() const;
+
+  void build_name_index();
+  void set_name_index(NameIndex stop_index, NameIndex bus_index);
+  const NameIndex &get_stop_index() const;
+  const NameIndex &get_bus_index() const;
+
+  void build_name_trie();
+  void set_name_trie(NameTrie stop_trie);
+  const NameTrie &get_stop_trie() const;
+
+  void build_spatial_index();
+  void set_spatial_index(SpatialIndex spatial_index);
+  const SpatialIndex &get_spatial_index() const;
+
+  void refresh_network_stats();
+  void set_network_stats(NetworkStats stats);
+  // While not kept, changes leave the statistics alone; a base that stores
+  // them is loaded without counting them again.
+  void keep_network_stats(bool keeps);
+  const NetworkStats &get_network_stats() const;
+
   Bus *get_bus(std::string_view bus_name);
   Stop *get_stop(std::string_view stop_name);
 
-  std::deque<Stop> get_stops() const;
-  std::deque<Bus> get_buses() const;
-
-  BusMap get_busname_to_bus() const;
-  StopMap get_stopname_to_stop() const;
+  const std::pmr::deque<Stop> &get_stops() const;
+  const std::pmr::deque<Bus> &get_buses() const;
 
   std::unordered_set<const Bus *> stop_get_uniq_buses(Stop *stop);
   std::unordered_set<const Stop *> get_uniq_stops(Bus *bus);
   double get_length(Bus *bus);
 
-  DistanceMap get_distance() const;
   size_t get_distance_stop(const Stop *start, const Stop *finish) const;
   size_t get_distance_to_bus(Bus *bus);
 
 private:
-  std::deque<Stop> stops;
+  void attach_bus(Bus *bus);
+  void detach_bus(Bus *bus);
+  void update_route_length(const Stop *stop);
+
+  std::unique_ptr<MemoryArena> arena_;
+  NameArena names_;
+
+  std::pmr::deque<Stop> stops;
   StopMap stopname_to_stop;
+  NameIndex stop_index_;
 
-  std::deque<Bus> buses;
+  std::pmr::deque<Bus> buses;
   BusMap busname_to_bus;
+  NameIndex bus_index_;
+
+  NetworkStats stats_;
+  bool keeps_network_stats_ = true;
 
-  DistanceMap distance_to_stop;
+  NameTrie stop_trie_;
+  SpatialIndex spatial_index_;
 };
 
 } // end namespace transport_catalogue
\ No newline at end of file
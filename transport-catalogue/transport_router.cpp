@@ -11,12 +11,31 @@ const RoutingSettings &TransportRouter::get_routing_settings() const {
   return routing_settings_;
 }
 
-void TransportRouter::build_router(TransportCatalogue &transport_catalogue) {
-  set_graph(transport_catalogue);
+void TransportRouter::build_router(const FrozenCatalogue &catalogue) {
+  set_graph(catalogue);
   router_ = std::make_unique<Router<double>>(*graph_);
   router_->build();
 }
 
+void TransportRouter::build_router(const FrozenCatalogue &catalogue,
+                                   const RouteTable &route_table) {
+  set_graph(catalogue);
+
+  if (route_table.get_vertex_count() != graph_->get_vertex_count() ||
+      route_table.get_edge_count() != graph_->get_edge_count() ||
+      route_table.get_graph_hash() != hash_graph(*graph_)) {
+    router_ = std::make_unique<Router<double>>(*graph_);
+    router_->build();
+    return;
+  }
+
+  router_ = std::make_unique<Router<double>>(*graph_, route_table);
+}
+
+void TransportRouter::save_route_table(std::ostream &out) const {
+  router_->save(out);
+}
+
 const DirectedWeightedGraph<double> &TransportRouter::get_graph() const {
   return *graph_;
 }
@@ -26,13 +45,9 @@ TransportRouter::get_edge(EdgeId id) const {
   return edge_id_to_edge_.at(id);
 }
 
-std::optional<RouterByStop>
-TransportRouter::get_router_by_stop(Stop *stop) const {
-  if (stop_to_router_.count(stop)) {
-    return stop_to_router_.at(stop);
-  } else {
-    return std::nullopt;
-  }
+RouterByStop TransportRouter::get_router_by_stop(uint32_t stop_id) {
+  return RouterByStop{2 * static_cast<VertexId>(stop_id),
+                      2 * static_cast<VertexId>(stop_id) + 1};
 }
 
 std::optional<RouteInfo>
@@ -53,88 +68,67 @@ TransportRouter::get_route_info(VertexId start, graph::VertexId end) const {
   }
 }
 
-const std::unordered_map<Stop *, RouterByStop> &
-TransportRouter::get_stop_to_vertex() const {
-  return stop_to_router_;
-}
-const std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> &
+const std::pmr::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> &
 TransportRouter::get_edge_id_to_edge() const {
   return edge_id_to_edge_;
 }
 
-std::deque<Stop *>
-TransportRouter::get_stops_ptr(TransportCatalogue &transport_catalogue) {
-  std::deque<Stop *> stops_ptr;
-
-  for (auto [_, stop_ptr] : transport_catalogue.get_stopname_to_stop()) {
-    stops_ptr.push_back(stop_ptr);
-  }
-
-  return stops_ptr;
-}
-
-std::deque<Bus *>
-TransportRouter::get_bus_ptr(TransportCatalogue &transport_catalogue) {
-  std::deque<Bus *> buses_ptr;
-
-  for (auto [_, bus_ptr] : transport_catalogue.get_busname_to_bus()) {
-    buses_ptr.push_back(bus_ptr);
-  }
-
-  return buses_ptr;
-}
-
-void TransportRouter::set_stops(const std::deque<Stop *> &stops) {
-  size_t i = 0;
+// The edges are added in the order of the stops, so that edge ids are the
+// same in every run and a route table can refer to them.
+void TransportRouter::add_edge_to_stop(const FrozenCatalogue &catalogue) {
 
-  for (const auto stop : stops) {
-    VertexId first = i++;
-    VertexId second = i++;
+  for (const auto &stop : catalogue.get_stops()) {
+    const RouterByStop num = get_router_by_stop(catalogue.get_stop_id(stop));
+    EdgeId id = graph_->add_edge(Edge<double>{
+        num.bus_wait_start, num.bus_wait_end, routing_settings_.bus_wait_time});
 
-    stop_to_router_[stop] = RouterByStop{first, second};
+    edge_id_to_edge_[id] =
+        StopEdge{catalogue.get_name(stop.name),
+                 routing_settings_.bus_wait_time};
   }
 }
 
-void TransportRouter::add_edge_to_stop() {
+void TransportRouter::add_edge_to_bus(const FrozenCatalogue &catalogue) {
 
-  for (const auto [stop, num] : stop_to_router_) {
-    EdgeId id = graph_->add_edge(Edge<double>{
-        num.bus_wait_start, num.bus_wait_end, routing_settings_.bus_wait_time});
-
-    edge_id_to_edge_[id] =
-        StopEdge{stop->name, routing_settings_.bus_wait_time};
+  for (const auto &bus : catalogue.get_buses()) {
+    parse_bus_to_edges(catalogue, bus);
   }
 }
 
-void TransportRouter::add_edge_to_bus(TransportCatalogue &transport_catalogue) {
+void TransportRouter::parse_bus_to_edges(const FrozenCatalogue &catalogue,
+                                         const FrozenBus &bus) {
+  const auto bus_stops = catalogue.get_bus_stops(bus);
+  const size_t stops_count = bus_stops.size();
 
-  for (auto bus : get_bus_ptr(transport_catalogue)) {
-    parse_bus_to_edges(bus->stops.begin(), bus->stops.end(),
-                       transport_catalogue, bus);
+  for (size_t from = 0; from < stops_count; ++from) {
+    for (size_t to = from + 1; to < stops_count; ++to) {
+      EdgeId id = graph_->add_edge(make_edge_to_bus(
+          bus_stops[from], bus_stops[to],
+          static_cast<double>(catalogue.get_road_length(bus, from, to))));
 
-    if (!bus->is_roundtrip) {
-      parse_bus_to_edges(bus->stops.rbegin(), bus->stops.rend(),
-                         transport_catalogue, bus);
+      edge_id_to_edge_[id] =
+          BusEdge{catalogue.get_name(bus.name), to - from,
+                  graph_->get_edge(id).weight};
     }
   }
 }
 
-void TransportRouter::set_graph(TransportCatalogue &transport_catalogue) {
-  const auto stops_ptr_size = get_stops_ptr(transport_catalogue).size();
+void TransportRouter::set_graph(const FrozenCatalogue &catalogue) {
+  const auto stops_size = catalogue.get_stops().size();
 
-  graph_ = std::make_unique<DirectedWeightedGraph<double>>(2 * stops_ptr_size);
+  graph_ = std::make_unique<DirectedWeightedGraph<double>>(2 * stops_size);
 
-  set_stops(get_stops_ptr(transport_catalogue));
-  add_edge_to_stop();
-  add_edge_to_bus(transport_catalogue);
+  add_edge_to_stop(catalogue);
+  add_edge_to_bus(catalogue);
 }
 
-Edge<double> TransportRouter::make_edge_to_bus(Stop *start, Stop *end,
+Edge<double> TransportRouter::make_edge_to_bus(uint32_t start_id,
+                                               uint32_t end_id,
                                                const double distance) const {
   Edge<double> result;
 
-  result.from = stop_to_router_.at(start).bus_wait_end;
-  result.to = stop_to_router_.at(end).bus_wait_start;
+  result.from = get_router_by_stop(start_id).bus_wait_end;
+  result.to = get_router_by_stop(end_id).bus_wait_start;
   result.weight =
       distance * 1.0 / (routing_settings_.bus_velocity * KILOMETER / HOUR);
 
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "domain.h"
+#include "frozen_catalogue.h"
+#include "memory_arena.h"
+#include "route_table.h"
 #include "router.h"
-#include "transport_catalogue.h"
 
 #include <deque>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <unordered_map>
 
 namespace transport_catalogue {
@@ -23,39 +27,42 @@ public:
   void set_routing_settings(RoutingSettings routing_settings);
   const RoutingSettings &get_routing_settings() const;
 
-  void build_router(TransportCatalogue &transport_catalogue);
+  void build_router(const FrozenCatalogue &catalogue);
+  // Takes the routes from a table written by save_route_table if it was
+  // written for the same graph, and computes them otherwise. The table must
+  // outlive the router.
+  void build_router(const FrozenCatalogue &catalogue,
+                    const RouteTable &route_table);
+  void save_route_table(std::ostream &out) const;
 
   const DirectedWeightedGraph<double> &get_graph() const;
   const Router<double> &get_router() const;
   const std::variant<StopEdge, BusEdge> &get_edge(EdgeId id) const;
 
-  std::optional<RouterByStop> get_router_by_stop(Stop *stop) const;
+  // A stop has the vertices 2 * id and 2 * id + 1, so they are computed from
+  // its id instead of being kept in a table.
+  static RouterByStop get_router_by_stop(uint32_t stop_id);
   std::optional<RouteInfo> get_route_info(VertexId start, VertexId end) const;
 
-  const std::unordered_map<Stop *, RouterByStop> &get_stop_to_vertex() const;
-  const std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> &
+  const std::pmr::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> &
   get_edge_id_to_edge() const;
 
-  std::deque<Stop *> get_stops_ptr(TransportCatalogue &transport_catalogue);
-  std::deque<Bus *> get_bus_ptr(TransportCatalogue &transport_catalogue);
+  void add_edge_to_stop(const FrozenCatalogue &catalogue);
+  void add_edge_to_bus(const FrozenCatalogue &catalogue);
 
-  void add_edge_to_stop();
-  void add_edge_to_bus(TransportCatalogue &transport_catalogue);
+  void set_graph(const FrozenCatalogue &catalogue);
 
-  void set_stops(const std::deque<Stop *> &stops);
-  void set_graph(TransportCatalogue &transport_catalogue);
-
-  Edge<double> make_edge_to_bus(Stop *start, Stop *end,
+  Edge<double> make_edge_to_bus(uint32_t start_id, uint32_t end_id,
                                 const double distance) const;
 
-  template <typename Iterator>
-  void parse_bus_to_edges(Iterator first, Iterator last,
-                          const TransportCatalogue &transport_catalogue,
-                          const Bus *bus);
+  void parse_bus_to_edges(const FrozenCatalogue &catalogue,
+                          const FrozenBus &bus);
 
 private:
-  std::unordered_map<Stop *, RouterByStop> stop_to_router_;
-  std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> edge_id_to_edge_;
+  std::unique_ptr<MemoryArena> arena_ = std::make_unique<MemoryArena>();
+
+  std::pmr::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>>
+      edge_id_to_edge_{arena_.get()};
 
   std::unique_ptr<DirectedWeightedGraph<double>> graph_;
   std::unique_ptr<Router<double>> router_;
@@ -63,27 +70,6 @@ private:
   RoutingSettings routing_settings_;
 };
 
-template <typename Iterator>
-void TransportRouter::parse_bus_to_edges(
-    Iterator first, Iterator last,
-    const TransportCatalogue &transport_catalogue, const Bus *bus) {
-
-  for (auto it = first; it != last; ++it) {
-    size_t distance = 0;
-    size_t span = 0;
-
-    for (auto it2 = std::next(it); it2 != last; ++it2) {
-      distance += transport_catalogue.get_distance_stop(*prev(it2), *it2);
-      ++span;
-
-      EdgeId id = graph_->add_edge(make_edge_to_bus(*it, *it2, distance));
-
-      edge_id_to_edge_[id] =
-          BusEdge{bus->name, span, graph_->get_edge(id).weight};
-    }
-  }
-}
-
 } // end namespace router
 } // end namespace detail
 } // end namespace transport_catalogue
\ No newline at end of file